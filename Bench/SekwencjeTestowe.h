@@ -0,0 +1,33 @@
+#pragma once
+
+/**
+ * Standardowa sekwencja testowa 3D HP z najniższą znaną energią.
+ */
+struct SekwencjaTestowa {
+    const char* nazwa;
+    const char* sekwencja;
+    int energia_znana;   // najniższa znana energia (0 - nieznana, brak pomiaru czasu do celu)
+};
+
+/**
+ * Dziesięć 48-merów z Harvardu (Yue i in., PNAS 1995) z energiami
+ * stanu podstawowego na siatce sześciennej, 64-mer (Unger, Moult 1993;
+ * najniższa energia w 3D nieustalona), sekwencja ubikwityny z HP_model
+ * i krótka sekwencja kontrolna, której stan podstawowy hp_bench wyznacza
+ * dokładną enumeracją (klasa Enumeracja).
+ */
+inline const SekwencjaTestowa SEKWENCJE_TESTOWE[] = {
+    {"48-1",  "HPHHPPHHHHPHHHPPHHPPHPHHHPHPHHPPHHPPPHPPPPPPPPHH", -32},
+    {"48-2",  "HHHHPHHPHHHHHPPHPPHHPPHPPPPPPHPPHPPPHPPHHPPHHHPH", -34},
+    {"48-3",  "PHPHHPHHHHHHPPHPHPPHPHHPHPHPPPHPPHHPPHHPPHPHPPHP", -34},
+    {"48-4",  "PHPHHPPHPHHHPPHHPHHPPPHHHHHPPHPHHPHPHPPPPHPPHPHP", -33},
+    {"48-5",  "PPHPPPHPHHHHPPHHHHPHHPHHHPPHPHPHPPHPPPPPPHHPHHPH", -32},
+    {"48-6",  "HHHPPPHHPHPHHPHHPHHPHPPPPPPPHPHPPHPPPHPPHHHHHHPH", -32},
+    {"48-7",  "PHPPPPHPHHHPHPHHHHPHHPHHPPPHPHPPPHHHPPHHPPHHPPPH", -32},
+    {"48-8",  "PHHPHHHPHHHHPPHHHPPPPPPHPHHPPHHPHPPPHHPHPHPHHPPP", -31},
+    {"48-9",  "PHPHPPPPHPHPHPPHPHHHHHHPPHHHPHPPHPHHPPHPHHHPPPPH", -34},
+    {"48-10", "PHHPPPPPPHHPPPHHHPHPPHPHHPPHPPHPPHHPPHHHHHHHPPHH", -33},
+    {"64",    "HHHHHHHHHHHHPHPHPPHHPPHHPPHPPHHPPHHPPHPPHHPPHHPPHPHPHHHHHHHHHHHH", 0},
+    {"18",    "HPHPPHHPHPPHPHHPPH", 0},
+    {"ubikwityna", "PHPHHHHHPHPHPHHPPPPPHPPPPHHHPPPPPHPPPHHPHPHHHHPPPPHHHHPPHPHPHHHHHHHHHPPHHPP", 0},
+};
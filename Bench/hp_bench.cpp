@@ -0,0 +1,478 @@
+#include "Enumeracja.h"
+#include "HP_model.h"
+#include "Przeglad.h"
+#include "SekwencjeTestowe.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * hp_bench: pomiary wydajności na standardowych sekwencjach 3D HP.
+ *  - przepustowość każdego typu ruchu (kroki/s przy mieszance z jednym typem),
+ *  - kroki/s pełnego algorytmu_metropolisa (z zapisem wyjścia),
+ *  - czas (mediana, p90) i liczba kroków do osiągnięcia najniższej znanej energii
+ *    (dla krótkich sekwencji bez znanej energii - wyznaczonej dokładną enumeracją),
+ *    z opcją --porownaj-ruchy także dla zestawu ruchów bez pull moves,
+ *  - liczba alokacji na stercie w krokach krok_mc po rozgrzewce (powinna być zerowa).
+ * Kontrola (--kontrola) sprawdza dodatkowo spójność energii przyrostowej modeli HPNX i MJ.
+ * Ziarna są stałe, więc liczby kroków są powtarzalne, a czasy porównywalne między przebiegami.
+ * Z opcją --kontrola wykonuje tylko sprawdzenia (dla ctest) i kończy się kodem 1 przy błędzie.
+ */
+
+// Licznik wszystkich alokacji programu (zwykłe operator new; wersje [] i nothrow go wywołują)
+static std::atomic<long long> liczba_alokacji{0};
+
+void* operator new(std::size_t rozmiar) {
+    liczba_alokacji.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(rozmiar ? rozmiar : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    struct Opcje {
+        std::string format = "json";
+        std::string wyjscie;                // pusty - standardowe wyjście
+        std::string filtr;                  // nazwy sekwencji oddzielone przecinkami (puste - wszystkie)
+        uint64_t ziarno = 2024;
+        long long kroki_przepustowosci = 1000000;
+        int kroki_metropolisa = 1000000;
+        int powtorzenia = 5;
+        long long maks_krokow = 20000000;   // budżet kroków jednego przebiegu do celu
+        double T = 0.35;                    // temperatura przebiegów do celu
+        int margines = 0;                   // cel = energia znana + margines
+        int maks_dokladnie = 18;            // najdłuższa sekwencja do dokładnej enumeracji
+        long long kroki_alokacji = 200000;  // kroki liczenia alokacji (po rozgrzewce)
+        bool kontrola = false;              // tylko sprawdzenia, kod wyjścia 1 przy błędzie
+        bool porownaj_ruchy = false;        // czas do celu także bez pull moves
+    };
+
+    const char* const NAZWY_RUCHOW[] = {"koniec", "naroznik", "crankshaft", "pull"};
+
+    struct WynikPrzepustowosci {
+        std::string sekwencja;
+        std::string tryb;
+        std::string ruch;
+        long long kroki;
+        double kroki_na_s;
+        double akceptacja;
+    };
+
+    struct WynikMetropolisa {
+        std::string sekwencja;
+        int kroki;
+        double kroki_na_s;
+        int energia_koncowa;
+    };
+
+    struct WynikCelu {
+        std::string sekwencja;
+        std::string ruchy;      // "wszystkie" albo "bez_pull"
+        int energia_docelowa;
+        int przebiegi;
+        int sukcesy;
+        double mediana_s;       // NaN - cel nieosiągnięty w co najmniej połowie przebiegów
+        double p90_s;
+        double mediana_krokow;
+        int najlepsza_energia;
+    };
+
+    struct WynikAlokacji {
+        std::string sekwencja;
+        std::string tryb;
+        long long kroki;
+        long long alokacje;
+    };
+
+    double sekundy_od(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * Kwantyl metodą najbliższej rangi; nieudane przebiegi liczą się jako nieskończoność.
+     */
+    double kwantyl(std::vector<double> wartosci, double q) {
+        if (wartosci.empty()) return std::numeric_limits<double>::quiet_NaN();
+        std::sort(wartosci.begin(), wartosci.end());
+        const size_t ranga = static_cast<size_t>(std::ceil(q * wartosci.size()));
+        const double w = wartosci[std::max<size_t>(ranga, 1) - 1];
+        return std::isfinite(w) ? w : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    template <typename Model>
+    bool przygotuj_model(Model& model, uint64_t ziarno) {
+        model.ustaw_ziarno(ziarno);
+        model.ustaw_gadatliwosc(Gadatliwosc::Cisza);
+        for (int proby = 0; proby < 1000; ++proby) {
+            if (model.generuj_startowa_konformacje(true)) return true;
+        }
+        return false;
+    }
+
+    void zmierz_przepustowosc(const SekwencjaTestowa& s, const Opcje& opcje, uint64_t ziarno,
+                              std::vector<WynikPrzepustowosci>& wyniki) {
+        const HP_model::TrybPropozycji tryby[] = {HP_model::TrybPropozycji::WszystkieRuchy,
+                                                  HP_model::TrybPropozycji::Lokalny};
+        for (auto tryb : tryby) {
+            for (int typ = 0; typ < 4; ++typ) {
+                HP_model model(s.sekwencja);
+                if (!przygotuj_model(model, ziarno)) continue;
+                model.ustaw_tryb_propozycji(tryb);
+                double wagi[4] = {0.0, 0.0, 0.0, 0.0};
+                wagi[typ] = 1.0;
+                model.ustaw_mieszanke_ruchow(wagi[0], wagi[1], wagi[2], wagi[3]);
+
+                // T = 1: ruchy często akceptowane, konformacja nie zamarza
+                long long zaakceptowane = 0;
+                const auto start = std::chrono::steady_clock::now();
+                for (long long k = 0; k < opcje.kroki_przepustowosci; ++k) {
+                    zaakceptowane += model.krok_mc(1.0);
+                }
+                const double czas = sekundy_od(start);
+                wyniki.push_back({s.nazwa,
+                                  tryb == HP_model::TrybPropozycji::Lokalny ? "lokalny" : "wszystkie",
+                                  NAZWY_RUCHOW[typ], opcje.kroki_przepustowosci,
+                                  opcje.kroki_przepustowosci / czas,
+                                  static_cast<double>(zaakceptowane) / opcje.kroki_przepustowosci});
+            }
+        }
+    }
+
+    /**
+     * Alokacje w krokach krok_mc przy pełnej mieszance ruchów, po rozgrzewce, która
+     * ustala pojemności buforów (np. dopasowanie siatki po dryfie łańcucha).
+     */
+    void zmierz_alokacje(const SekwencjaTestowa& s, const Opcje& opcje, uint64_t ziarno,
+                         std::vector<WynikAlokacji>& wyniki) {
+        const HP_model::TrybPropozycji tryby[] = {HP_model::TrybPropozycji::WszystkieRuchy,
+                                                  HP_model::TrybPropozycji::Lokalny};
+        for (auto tryb : tryby) {
+            HP_model model(s.sekwencja);
+            if (!przygotuj_model(model, ziarno)) continue;
+            model.ustaw_tryb_propozycji(tryb);
+            for (int k = 0; k < 20000; ++k) model.krok_mc(1.0);
+
+            const long long przed = liczba_alokacji.load();
+            for (long long k = 0; k < opcje.kroki_alokacji; ++k) model.krok_mc(1.0);
+            wyniki.push_back({s.nazwa, tryb == HP_model::TrybPropozycji::Lokalny ? "lokalny" : "wszystkie",
+                              opcje.kroki_alokacji, liczba_alokacji.load() - przed});
+        }
+    }
+
+    struct WynikEnergii {
+        std::string model;
+        std::string tryb;
+        long long kroki;
+        int niezgodnosci;   // kontrole, w których energie się różniły
+    };
+
+    /**
+     * Spójność energii modelu macierzowego: co 1000 kroków krok_mc energia przyrostowa,
+     * energia_z_siatki i pełne przeliczenie oblicz_energie muszą być równe.
+     * Sekwencja jest losowa nad alfabetem tabeli, temperatura - ułamek typowej energii kontaktu.
+     */
+    template <typename Model, typename Tabela>
+    void sprawdz_energie_macierzy(const std::string& nazwa, size_t dlugosc, double T, uint64_t ziarno,
+                                  std::vector<WynikEnergii>& wyniki) {
+        Xoshiro256 gen(ziarno);
+        std::string sekwencja(dlugosc, ' ');
+        const size_t litery = sizeof(Tabela::LITERY) - 1;
+        for (char& c : sekwencja) c = Tabela::LITERY[gen.ponizej(litery)];
+
+        const typename Model::TrybPropozycji tryby[] = {Model::TrybPropozycji::WszystkieRuchy,
+                                                        Model::TrybPropozycji::Lokalny};
+        for (auto tryb : tryby) {
+            Model model(sekwencja);
+            if (!przygotuj_model(model, ziarno)) continue;
+            model.ustaw_tryb_propozycji(tryb);
+            WynikEnergii wynik{nazwa, tryb == Model::TrybPropozycji::Lokalny ? "lokalny" : "wszystkie", 200000, 0};
+            for (long long k = 1; k <= wynik.kroki; ++k) {
+                model.krok_mc(T);
+                if (k % 1000 != 0) continue;
+                const int przyrostowa = static_cast<int>(model.get_energia());
+                if (przyrostowa != model.energia_z_siatki() || przyrostowa != static_cast<int>(model.oblicz_energie())) {
+                    ++wynik.niezgodnosci;
+                }
+            }
+            wyniki.push_back(wynik);
+        }
+    }
+
+    void zmierz_metropolisa(const SekwencjaTestowa& s, const Opcje& opcje, uint64_t ziarno,
+                            const std::string& katalog, std::vector<WynikMetropolisa>& wyniki) {
+        HP_model model(s.sekwencja);
+        if (!przygotuj_model(model, ziarno)) return;
+        model.ustaw_interwal_raportu(0);
+        model.ustaw_katalog_wyjsciowy(katalog);
+        model.get_telemetria().ustaw_probkowanie(0);
+        model.algorytm_metropolisa(5.0, 0.3, 0.99999, opcje.kroki_metropolisa);
+        wyniki.push_back({s.nazwa, opcje.kroki_metropolisa,
+                          model.get_telemetria().kroki_na_sekunde(),
+                          static_cast<int>(model.get_energia())});
+    }
+
+    void zmierz_czas_do_celu(const SekwencjaTestowa& s, int energia_znana, const Opcje& opcje, uint64_t ziarno,
+                             bool z_pull, std::vector<WynikCelu>& wyniki) {
+        const int cel = energia_znana + opcje.margines;
+        std::vector<double> czasy, kroki;
+        int sukcesy = 0;
+        int najlepsza = 0;
+        for (int r = 0; r < opcje.powtorzenia; ++r) {
+            HP_model model(s.sekwencja);
+            if (!przygotuj_model(model, ziarno_przebiegu(ziarno, r))) continue;
+            model.ustaw_tryb_propozycji(HP_model::TrybPropozycji::Lokalny);
+            model.ustaw_mieszanke_ruchow(1.0, 1.0, 1.0, z_pull ? 1.0 : 0.0);
+
+            long long krok = 0;
+            const auto start = std::chrono::steady_clock::now();
+            while (model.get_energia() > cel && krok < opcje.maks_krokow) {
+                model.krok_mc(opcje.T);
+                ++krok;
+                najlepsza = std::min(najlepsza, static_cast<int>(model.get_energia()));
+            }
+            const double czas = sekundy_od(start);
+            const bool sukces = model.get_energia() <= cel;
+            sukcesy += sukces;
+            czasy.push_back(sukces ? czas : std::numeric_limits<double>::infinity());
+            kroki.push_back(sukces ? static_cast<double>(krok) : std::numeric_limits<double>::infinity());
+        }
+        wyniki.push_back({s.nazwa, z_pull ? "wszystkie" : "bez_pull", cel, static_cast<int>(czasy.size()), sukcesy,
+                          kwantyl(czasy, 0.5), kwantyl(czasy, 0.9), kwantyl(kroki, 0.5), najlepsza});
+    }
+
+    // Liczba w JSON: NaN jako null
+    std::string json_liczba(double x) {
+        if (!std::isfinite(x)) return "null";
+        std::ostringstream s;
+        s.precision(10);
+        s << x;
+        return s.str();
+    }
+
+    std::string csv_liczba(double x) {
+        return std::isfinite(x) ? json_liczba(x) : "";
+    }
+
+    void zapisz_json(std::ostream& out, const Opcje& opcje,
+                     const std::vector<WynikPrzepustowosci>& przepustowosc,
+                     const std::vector<WynikMetropolisa>& metropolis,
+                     const std::vector<WynikCelu>& cele,
+                     const std::vector<WynikAlokacji>& alokacje) {
+        out << "{\n";
+        out << "  \"ziarno\": " << opcje.ziarno << ",\n";
+        out << "  \"powtorzenia\": " << opcje.powtorzenia << ",\n";
+        out << "  \"maks_krokow\": " << opcje.maks_krokow << ",\n";
+        out << "  \"T\": " << json_liczba(opcje.T) << ",\n";
+        out << "  \"przepustowosc_ruchow\": [\n";
+        for (size_t i = 0; i < przepustowosc.size(); ++i) {
+            const auto& w = przepustowosc[i];
+            out << "    {\"sekwencja\": \"" << w.sekwencja << "\", \"tryb\": \"" << w.tryb
+                << "\", \"ruch\": \"" << w.ruch << "\", \"kroki\": " << w.kroki
+                << ", \"kroki_na_s\": " << json_liczba(w.kroki_na_s)
+                << ", \"akceptacja\": " << json_liczba(w.akceptacja) << "}"
+                << (i + 1 < przepustowosc.size() ? "," : "") << "\n";
+        }
+        out << "  ],\n";
+        out << "  \"metropolis\": [\n";
+        for (size_t i = 0; i < metropolis.size(); ++i) {
+            const auto& w = metropolis[i];
+            out << "    {\"sekwencja\": \"" << w.sekwencja << "\", \"kroki\": " << w.kroki
+                << ", \"kroki_na_s\": " << json_liczba(w.kroki_na_s)
+                << ", \"energia_koncowa\": " << w.energia_koncowa << "}"
+                << (i + 1 < metropolis.size() ? "," : "") << "\n";
+        }
+        out << "  ],\n";
+        out << "  \"czas_do_celu\": [\n";
+        for (size_t i = 0; i < cele.size(); ++i) {
+            const auto& w = cele[i];
+            out << "    {\"sekwencja\": \"" << w.sekwencja << "\", \"ruchy\": \"" << w.ruchy
+                << "\", \"energia_docelowa\": " << w.energia_docelowa
+                << ", \"przebiegi\": " << w.przebiegi << ", \"sukcesy\": " << w.sukcesy
+                << ", \"mediana_s\": " << json_liczba(w.mediana_s)
+                << ", \"p90_s\": " << json_liczba(w.p90_s)
+                << ", \"mediana_krokow\": " << json_liczba(w.mediana_krokow)
+                << ", \"najlepsza_energia\": " << w.najlepsza_energia << "}"
+                << (i + 1 < cele.size() ? "," : "") << "\n";
+        }
+        out << "  ],\n";
+        out << "  \"alokacje\": [\n";
+        for (size_t i = 0; i < alokacje.size(); ++i) {
+            const auto& w = alokacje[i];
+            out << "    {\"sekwencja\": \"" << w.sekwencja << "\", \"tryb\": \"" << w.tryb
+                << "\", \"kroki\": " << w.kroki << ", \"alokacje\": " << w.alokacje << "}"
+                << (i + 1 < alokacje.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n";
+        out << "}\n";
+    }
+
+    // Jedna tabela dla wszystkich pomiarów; kolumny spoza danego pomiaru są puste
+    void zapisz_csv(std::ostream& out,
+                    const std::vector<WynikPrzepustowosci>& przepustowosc,
+                    const std::vector<WynikMetropolisa>& metropolis,
+                    const std::vector<WynikCelu>& cele,
+                    const std::vector<WynikAlokacji>& alokacje) {
+        out << "pomiar,sekwencja,tryb,ruch,kroki,kroki_na_s,akceptacja,energia_koncowa,"
+               "energia_docelowa,przebiegi,sukcesy,mediana_s,p90_s,mediana_krokow,najlepsza_energia,alokacje\n";
+        for (const auto& w : przepustowosc) {
+            out << "przepustowosc," << w.sekwencja << "," << w.tryb << "," << w.ruch << ","
+                << w.kroki << "," << csv_liczba(w.kroki_na_s) << "," << csv_liczba(w.akceptacja)
+                << ",,,,,,,,,\n";
+        }
+        for (const auto& w : metropolis) {
+            out << "metropolis," << w.sekwencja << ",,," << w.kroki << "," << csv_liczba(w.kroki_na_s)
+                << ",," << w.energia_koncowa << ",,,,,,,,\n";
+        }
+        for (const auto& w : cele) {
+            out << "czas_do_celu," << w.sekwencja << ",lokalny," << w.ruchy << ",,,,," << w.energia_docelowa << ","
+                << w.przebiegi << "," << w.sukcesy << "," << csv_liczba(w.mediana_s) << ","
+                << csv_liczba(w.p90_s) << "," << csv_liczba(w.mediana_krokow) << ","
+                << w.najlepsza_energia << ",\n";
+        }
+        for (const auto& w : alokacje) {
+            out << "alokacje," << w.sekwencja << "," << w.tryb << ",," << w.kroki << ",,,,,,,,,,,"
+                << w.alokacje << "\n";
+        }
+    }
+
+    void wypisz_pomoc(const char* program) {
+        std::cerr << "Użycie: " << program << " [opcje]\n"
+                  << "  --format json|csv        format wyniku (domyślnie json)\n"
+                  << "  --wyjscie PLIK           plik wynikowy (domyślnie standardowe wyjście)\n"
+                  << "  --sekwencje A,B,...     tylko wybrane sekwencje (np. 48-1,64)\n"
+                  << "  --ziarno N               ziarno bazowe (domyślnie 2024)\n"
+                  << "  --kroki-przepustowosci N kroki pomiaru każdego typu ruchu\n"
+                  << "  --kroki-metropolisa N    kroki pomiaru algorytmu_metropolisa\n"
+                  << "  --powtorzenia N          przebiegi do celu na sekwencję\n"
+                  << "  --maks-krokow N          budżet kroków przebiegu do celu\n"
+                  << "  --T T                    temperatura przebiegów do celu\n"
+                  << "  --margines K             cel = najniższa znana energia + K\n"
+                  << "  --maks-dokladnie L       enumeracja dokładna sekwencji bez znanej energii do L aminokwasów\n"
+                  << "  --kroki-alokacji N       kroki liczenia alokacji po rozgrzewce\n"
+                  << "  --porownaj-ruchy         czas do celu także dla zestawu ruchów bez pull moves\n"
+                  << "  --kontrola               tylko sprawdzenia (alokacje w kroku, energia HPNX/MJ), kod 1 przy błędzie\n";
+    }
+
+    bool wczytaj_opcje(int argc, char* argv[], Opcje& opcje) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string nazwa = argv[i];
+            if (nazwa == "--kontrola") {
+                opcje.kontrola = true;
+                continue;
+            }
+            if (nazwa == "--porownaj-ruchy") {
+                opcje.porownaj_ruchy = true;
+                continue;
+            }
+            if (i + 1 >= argc) return false;
+            const char* wartosc = argv[++i];
+            if (nazwa == "--format") opcje.format = wartosc;
+            else if (nazwa == "--wyjscie") opcje.wyjscie = wartosc;
+            else if (nazwa == "--sekwencje") opcje.filtr = wartosc;
+            else if (nazwa == "--ziarno") opcje.ziarno = std::strtoull(wartosc, nullptr, 10);
+            else if (nazwa == "--kroki-przepustowosci") opcje.kroki_przepustowosci = std::atoll(wartosc);
+            else if (nazwa == "--kroki-metropolisa") opcje.kroki_metropolisa = std::atoi(wartosc);
+            else if (nazwa == "--powtorzenia") opcje.powtorzenia = std::atoi(wartosc);
+            else if (nazwa == "--maks-krokow") opcje.maks_krokow = std::atoll(wartosc);
+            else if (nazwa == "--T") opcje.T = std::atof(wartosc);
+            else if (nazwa == "--margines") opcje.margines = std::atoi(wartosc);
+            else if (nazwa == "--maks-dokladnie") opcje.maks_dokladnie = std::atoi(wartosc);
+            else if (nazwa == "--kroki-alokacji") opcje.kroki_alokacji = std::atoll(wartosc);
+            else return false;
+        }
+        return opcje.format == "json" || opcje.format == "csv";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Opcje opcje;
+    if (!wczytaj_opcje(argc, argv, opcje)) {
+        wypisz_pomoc(argv[0]);
+        return 1;
+    }
+
+    // Pliki wyjściowe algorytmu_metropolisa trafiają do katalogu tymczasowego
+    namespace fs = std::filesystem;
+    const fs::path katalog = fs::temp_directory_path() / "hp_bench";
+    fs::create_directories(katalog);
+
+    std::vector<WynikPrzepustowosci> przepustowosc;
+    std::vector<WynikMetropolisa> metropolis;
+    std::vector<WynikCelu> cele;
+    std::vector<WynikAlokacji> alokacje;
+    uint64_t numer = 0;
+    for (const auto& s : SEKWENCJE_TESTOWE) {
+        ++numer;
+        if (!opcje.filtr.empty() && ("," + opcje.filtr + ",").find("," + std::string(s.nazwa) + ",") == std::string::npos) continue;
+        std::cerr << "Sekwencja " << s.nazwa << "..." << std::endl;
+
+        const uint64_t ziarno = ziarno_przebiegu(opcje.ziarno, numer);
+        zmierz_alokacje(s, opcje, ziarno, alokacje);
+        if (opcje.kontrola) continue;
+        zmierz_przepustowosc(s, opcje, ziarno, przepustowosc);
+        zmierz_metropolisa(s, opcje, ziarno, katalog.string(), metropolis);
+        // Krótka sekwencja bez znanej energii: stan podstawowy z dokładnej enumeracji
+        int energia_znana = s.energia_znana;
+        if (energia_znana == 0 && std::string(s.sekwencja).size() <= static_cast<size_t>(opcje.maks_dokladnie)) {
+            Enumeracja enumeracja(s.sekwencja, UstawieniaEnumeracji{});
+            if (enumeracja.uruchom()) energia_znana = enumeracja.get_energia_minimalna();
+            std::cerr << "  enumeracja: E_min = " << energia_znana << ", degeneracja "
+                      << enumeracja.get_degeneracja() << ", " << enumeracja.get_czas() << " s" << std::endl;
+        }
+        if (energia_znana != 0 && opcje.powtorzenia > 0) {
+            zmierz_czas_do_celu(s, energia_znana, opcje, ziarno, true, cele);
+            if (opcje.porownaj_ruchy) zmierz_czas_do_celu(s, energia_znana, opcje, ziarno, false, cele);
+        }
+    }
+
+    if (opcje.kontrola) {
+        std::vector<WynikEnergii> energie;
+        sprawdz_energie_macierzy<HPNX_model, TabelaHPNX>("hpnx", 64, 1.5, opcje.ziarno, energie);
+        sprawdz_energie_macierzy<MJ_model, TabelaMJ>("mj", 64, 0.5 * TabelaMJ::SKALA, opcje.ziarno, energie);
+        bool ok = true;
+        for (const auto& w : energie) {
+            std::cout << "energia " << w.model << " (" << w.tryb << "): " << w.niezgodnosci
+                      << " niezgodności w " << w.kroki << " krokach" << std::endl;
+            ok = ok && w.niezgodnosci == 0;
+        }
+        for (const auto& w : alokacje) {
+            std::cout << "alokacje " << w.sekwencja << " (" << w.tryb << "): " << w.alokacje
+                      << " w " << w.kroki << " krokach" << std::endl;
+            ok = ok && w.alokacje == 0;
+        }
+        return ok ? 0 : 1;
+    }
+
+    std::ofstream plik;
+    if (!opcje.wyjscie.empty()) {
+        plik.open(opcje.wyjscie);
+        if (!plik) {
+            std::cerr << "Nie można otworzyć pliku " << opcje.wyjscie << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = opcje.wyjscie.empty() ? std::cout : plik;
+    if (opcje.format == "csv") {
+        zapisz_csv(out, przepustowosc, metropolis, cele, alokacje);
+    } else {
+        zapisz_json(out, opcje, przepustowosc, metropolis, cele, alokacje);
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Vec3.h"
+
+/**
+ * Ustawienia dokładnej enumeracji.
+ */
+struct UstawieniaEnumeracji {
+    size_t watki = 0;               // 0 - liczba rdzeni
+    int energia_gorna = 0;          // energia osiągnięta np. wyżarzaniem (górne oszacowanie E_min), 0 - brak
+    long long wezly_perm = 1000000; // krótki PERM przed enumeracją jako oszacowanie (0 - bez)
+    long long maks_wezlow = 0;      // limit odwiedzonych węzłów drzewa (0 - bez limitu)
+};
+
+/**
+ * Klasa Enumeracja: dokładny stan podstawowy sekwencji HP przez pełne
+ * przeszukanie łańcuchów samounikających na siatce sześciennej.
+ *
+ * - Łamanie symetrii: pierwsze wiązanie to +x, pierwsze wiązanie poza osią x to +y,
+ *   a pierwsze poza płaszczyzną xy to +z, więc każda klasa 48 obrazów symetrycznych
+ *   jest odwiedzana dokładnie raz (odwrócenie łańcucha nie jest utożsamiane).
+ * - Podział i ograniczenia: gałąź jest odcinana, gdy bieżące kontakty H-H plus
+ *   górne oszacowanie kontaktów pozostałych aminokwasów nie dorównują najlepszemu
+ *   wynikowi. Oszacowanie statyczne (parzystość siatki: kontakt tylko przy
+ *   nieparzystej różnicy indeksów >= 3, najwyżej 4 kontakty na aminokwas, 5 na końcu)
+ *   jest O(1); gdy nie wystarcza, liczone jest dynamiczne - z wolnych sąsiadów
+ *   już ułożonych aminokwasów H.
+ * - Oszacowanie startowe: energia krótkiego przebiegu PERM (lub podana energia_gorna)
+ *   od początku zaostrza odcinanie; jest osiągalna, więc nie zmienia wyniku.
+ * - Równoległość: prefiksy łańcucha do stałej głębokości są zadaniami PulaWatkow;
+ *   najlepszy wynik jest współdzielony (atomowo), więc odcinanie działa między wątkami.
+ *
+ * Degeneracja to liczba różnych konformacji o energii minimalnej z dokładnością
+ * do symetrii siatki. Koszt rośnie 2-4 razy z każdym aminokwasem: 18-mer to sekundy
+ * na jednym rdzeniu, 20-mer - minuty; dłuższe łańcuchy wymagają wielu rdzeni
+ * (zadania skalują się liniowo) albo energia_gorna bliskiej optimum.
+ */
+class Enumeracja {
+public:
+    Enumeracja(const std::string& sekwencja, const UstawieniaEnumeracji& ustawienia);
+
+    /**
+     * Przeszukuje całe drzewo konformacji.
+     * @return true jeśli przeszukiwanie było pełne (nie przerwane limitem węzłów)
+     *         i znaleziono co najmniej jedną konformację
+     */
+    bool uruchom();
+
+    /**
+     * Zapisuje przykładową konformację o energii minimalnej (format koncowa_konformacja.txt).
+     */
+    bool zapisz_konformacje(const std::string& sciezka) const;
+
+    /**
+     * Wypisuje energię minimalną, degenerację, liczbę węzłów drzewa i czas.
+     */
+    void wypisz_statystyki(std::ostream& out) const;
+
+    int get_energia_minimalna() const { return energia_minimalna; }
+    uint64_t get_degeneracja() const { return degeneracja; }
+    const std::vector<Vec3>& get_konformacja() const { return konformacja; }
+    long long get_wezly() const { return wezly; }
+    double get_czas() const { return czas; }
+    bool get_pelne() const { return pelne; }
+
+private:
+    std::string sekwencja;
+    UstawieniaEnumeracji ustawienia;
+
+    int energia_minimalna;
+    uint64_t degeneracja;
+    std::vector<Vec3> konformacja;
+    long long wezly;
+    size_t zadania;
+    double czas;
+    bool pelne;
+};
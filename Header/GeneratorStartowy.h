@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Vec3.h"
+#include "Siatka.h"
+#include "Losowanie.h"
+
+/**
+ * Ustawienia generatora konformacji startowych.
+ */
+struct UstawieniaGeneratora {
+    int glebokosc_cofania = 64;     // najwięcej aminokwasów zdejmowanych poniżej najgłębszego punktu
+    int maks_restartow = 10000;     // restarty od pierwszego aminokwasu przed porażką
+};
+
+/**
+ * Klasa GeneratorStartowy: losowe konformacje startowe (łańcuchy samounikające)
+ * dowolnej długości w czasie O(N).
+ *
+ * - Wzrost z podglądem (Rosenbluth): następny węzeł losowany jest spośród wolnych
+ *   sąsiadów z wagą równą liczbie wolnych sąsiadów kandydata, a kandydaci bez
+ *   wolnych sąsiadów (ślepe zaułki) są pomijani, więc łańcuch omija pułapki.
+ * - Ograniczone cofanie: gdy mimo to brak kandydata, łańcuch zdejmuje aminokwasy
+ *   i próbuje niewypróbowanych kierunków, najwyżej glebokosc_cofania poniżej
+ *   najgłębszego osiągniętego punktu; dopiero potem zaczyna od nowa.
+ *
+ * Wagi nie są korygowane, więc konformacje nie pochodzą z rozkładu jednostajnego
+ * (są nieco bardziej rozciągnięte) - wystarcza to jako start symulacji.
+ */
+class GeneratorStartowy {
+public:
+    explicit GeneratorStartowy(const UstawieniaGeneratora& ustawienia = UstawieniaGeneratora());
+
+    /**
+     * Wyhodowuje łańcuch o długości sekwencji od węzła (0,0,0), wstawiając aminokwasy do siatki.
+     * Siatka nie może zawierać innych aminokwasów; po porażce pozostaje pusta.
+     * @return false po wyczerpaniu maks_restartow
+     */
+    bool generuj(const std::string& sekwencja, SiatkaZajetosci& siatka, Xoshiro256& gen,
+                 std::vector<Vec3>& pozycje);
+
+    /**
+     * Wsad `liczba` niezależnych konformacji (np. dla wielu startów): konformacja k
+     * używa generatora z ziarnem ziarno_przebiegu(ziarno, k) (bez O(k) skoków strumienia),
+     * więc wynik nie zależy od liczby wątków.
+     * Każdy wątek używa jednej siatki, czyszczonej po każdej konformacji w O(N).
+     * @param watki liczba wątków (0 - liczba rdzeni)
+     * @return konformacje w kolejności k (pusta - porażka)
+     */
+    static std::vector<std::vector<Vec3>> generuj_wiele(const std::string& sekwencja, size_t liczba,
+                                                        uint64_t ziarno, size_t watki = 0,
+                                                        const UstawieniaGeneratora& ustawienia = UstawieniaGeneratora());
+
+    long long get_cofniecia() const { return cofniecia; }
+    long long get_restarty() const { return restarty; }
+
+private:
+    UstawieniaGeneratora ustawienia;
+    std::vector<uint8_t> wyprobowane;   // maska kierunków wypróbowanych dla każdego aminokwasu
+    long long cofniecia;
+    long long restarty;
+
+    int wolni_sasiedzi(const SiatkaZajetosci& siatka, const Vec3& p) const;
+};
@@ -1,28 +1,89 @@
 #pragma once
+#include <cstdint>
 #include <string>
-#include <unordered_map>
 #include <vector>
-#include <random>
 #include "Vec3.h"
+#include "KluczKonformacji.h"
+#include "Losowanie.h"
+#include "Oddzialywanie.h"
+#include "Siatka.h"
+#include "Telemetria.h"
+#include "ZapisAsynchroniczny.h"
+
+class PamiecKonformacji;
+class HarmonogramTemperatury;
+class StatystykiPrzebiegu;
+class DetektorZbieznosci;
+class SzachownicaMC;
 
 /**
- * Klasa HP_model: modeluje zwijanie białka w modelu HP na 3D siatce.
- * Obsługuje trzy ruchy: przesunięcie końca, obrót narożnika, crankshaft.
+ * Klasa Model: modeluje zwijanie białka na 3D siatce z energią kontaktową
+ * określoną polityką Oddzialywanie (zob. Oddzialywanie.h); HP_model to model HP.
+ * Obsługuje cztery ruchy: przesunięcie końca, obrót narożnika, crankshaft i pull move.
  * Implementuje algorytm Metropolisa z symulowanym wyżarzaniem.
+ * Ruchy, ΔE i pętla wyżarzania są kompilowane osobno dla każdej polityki
+ * (jawne instancje w HP_model.cpp).
  */
-
-class HP_model {
+template <typename Oddzialywanie>
+class Model {
 public:
-    HP_model();
+    /**
+     * Sposób proponowania ruchów w algorytmie Metropolisa.
+     * WszystkieRuchy - wylicza wszystkie dozwolone ruchy danego typu i losuje jeden (O(N)).
+     * Lokalny - losuje aminokwas i wariant ruchu, sprawdza legalność lokalnie (O(1)).
+     *   Liczba wariantów nie zależy od stanu, a ruch nielegalny liczy się jako
+     *   odrzucony, więc propozycje są symetryczne i spełniona jest równowaga szczegółowa.
+     */
+    enum class TrybPropozycji { WszystkieRuchy, Lokalny };
+
+    Model();
+
+    /**
+     * Model dowolnej sekwencji w alfabecie polityki (dla HP każda litera poza H to P).
+     * @throws std::invalid_argument dla litery spoza alfabetu polityki
+     */
+    explicit Model(const std::string& sekwencja);
+
+    /**
+     * Ustawia ziarno generatora liczb losowych (domyślnie std::random_device),
+     * dzięki czemu przebieg można odtworzyć.
+     */
+    void ustaw_ziarno(uint64_t ziarno);
+
+    /**
+     * Niezależny strumień `numer` generatora dla wspólnego ziarna (skok xoshiro256**
+     * o numer * 2^128) - dla łańcuchów, replik lub wątków jednego przebiegu.
+     */
+    void ustaw_strumien(uint64_t ziarno, uint64_t numer);
+
+    /**
+     * Wybór sposobu proponowania ruchów (domyślnie WszystkieRuchy).
+     */
+    void ustaw_tryb_propozycji(TrybPropozycji tryb) { tryb_propozycji = tryb; }
+    TrybPropozycji get_tryb_propozycji() const { return tryb_propozycji; }
+
+    /**
+     * Względne wagi losowania typów ruchu (domyślnie 1, 1, 1, 1).
+     * Waga 0 wyłącza dany typ; np. (1, 1, 1, 0) to zestaw bez pull moves.
+     */
+    void ustaw_mieszanke_ruchow(double koniec, double naroznik, double crankshaft, double pull);
 
     /**
-     * Inicjalizuje konformację białka w linii lub losowo (self-avoiding walk).
+     * Inicjalizuje konformację białka w linii lub losowo (self-avoiding walk
+     * rosnący z podglądem i ograniczonym cofaniem, zob. GeneratorStartowy).
      * @param losowa true - losowa, false - linia prosta
-     * @param max_proby maksymalna liczba prób wygenerowania konformacji
+     * @param max_proby maksymalna liczba restartów wzrostu od pierwszego aminokwasu
      * @return true jeśli udało się wygenerować konformację
      */
     bool generuj_startowa_konformacje(bool losowa = true, int max_proby = 10000);
 
+    /**
+     * Ustawia gotową konformację (np. z GeneratorStartowy::generuj_wiele przy wielu startach).
+     * @return false, jeśli długość się nie zgadza albo łańcuch nie jest samounikający
+     *         (model zachowuje wtedy poprzednią konformację)
+     */
+    bool ustaw_konformacje(const std::vector<Vec3>& nowe_pozycje);
+
     /**
      * Symulacja zwijania metodą Metropolisa z wyżarzaniem.
      * @param T0 początkowa temperatura
@@ -33,45 +94,318 @@ public:
     void algorytm_metropolisa(double T0, double T_inf, double alpha, int steps);
 
     /**
-     * Wypisuje statystyki ruchów po zakończeniu symulacji.
+     * Harmonogram temperatury algorytmu_metropolisa (nullptr - geometryczny
+     * z alpha i T_inf podanych w wywołaniu). Obiekt musi istnieć do końca przebiegu.
+     */
+    void ustaw_harmonogram(HarmonogramTemperatury* h) { harmonogram = h; }
+
+    /**
+     * Detektor zbieżności algorytmu_metropolisa (nullptr - zawsze pełne `steps` kroków).
+     * Przy restarcie łańcuch dostaje nową losową konformację i temperaturę T0,
+     * a po przebiegu z restartami model wraca do najlepszej znalezionej konformacji.
+     */
+    void ustaw_detektor_zbieznosci(DetektorZbieznosci* d) { detektor = d; }
+
+    /**
+     * Statystyki energii liczone w algorytmie_metropolisa krok po kroku (nullptr - wyłączone).
+     * Nowy przebieg je zeruje; po przebiegu podsumowanie trafia do statystyki.txt.
+     */
+    void ustaw_statystyki(StatystykiPrzebiegu* s) { statystyki = s; }
+
+    /**
+     * Czy algorytm_metropolisa zapisuje energię każdego kroku do energia.txt
+     * (domyślnie tak; przy włączonych statystykach zwykle zbędne).
+     */
+    void ustaw_zapis_energii(bool zapisuj) { zapis_energii = zapisuj; }
+
+    /**
+     * Czy algorytm_metropolisa zapisuje jakiekolwiek pliki (energia.txt, trajektoria.bin,
+     * koncowa_konformacja.txt, statystyki.txt). Wyłączone np. przy wywołaniu z biblioteki,
+     * gdy wynik odczytywany jest z get_energia() i get_pozycje(); nie działa wtedy wątek zapisu.
+     */
+    void ustaw_zapis_plikow(bool zapisuj) { zapis_plikow = zapisuj; }
+
+    /**
+     * Numer ostatniego kroku ostatniego algorytmu_metropolisa plus jeden
+     * (mniej niż `steps`, jeśli detektor zakończył przebieg wcześniej).
+     */
+    long long get_kroki_przebiegu() const { return kroki_przebiegu; }
+
+    /**
+     * Najniższa energia i jej konformacja z ostatniego algorytmu_metropolisa
+     * (śledzone zawsze, także bez detektora, gdy model kończy w stanie końcowym).
+     */
+    int get_najlepsza_energia() const { return najlepsza_energia_przebiegu; }
+    const std::vector<Vec3>& get_najlepsze_pozycje() const { return najlepsze_pozycje; }
+
+    /**
+     * Pojedynczy krok Metropolisa w stałej temperaturze, bez zapisu wyjścia.
+     * Rdzeń algorytmu_metropolisa; używany też przez wymianę replik.
+     * @param T temperatura
+     * @param mierz czy mierzyć czas faz kroku (telemetria)
+     * @return true jeśli ruch zaproponowano i zaakceptowano
+     */
+    bool krok_mc(double T, bool mierz = false);
+
+    /**
+     * Pojedynczy krok z dowolnym kryterium akceptacji akceptuj(dE, log_stosunek) -> bool,
+     * wywoływanym przy niezmienionej get_energia(). log_stosunek to logarytm
+     * ilorazu prawdopodobieństw propozycji ruchu odwrotnego i danego
+     * (poprawka Hastingsa; 0 dla ruchów symetrycznych). Propozycja, ΔE i cofanie
+     * jak w krok_mc; używany np. przez próbkowanie Wanga-Landaua.
+     * @return true jeśli ruch zaproponowano i zaakceptowano
+     */
+    template <typename Kryterium>
+    bool krok(Kryterium&& akceptuj, bool mierz = false) {
+        Ruch ruch;
+        int typ_ruchu, dE;
+        bool akceptacja = false;
+        const bool zaproponowano = zaproponuj_ruch(ruch, typ_ruchu, dE, mierz);
+        typ_ostatniego_ruchu = typ_ruchu;
+        if (zaproponowano) {
+            akceptacja = akceptuj(dE, log_stosunek_propozycji);
+            zakoncz_ruch(ruch, typ_ruchu, dE, akceptacja, mierz);
+        }
+        po_kroku();
+        return akceptacja;
+    }
+
+    /**
+     * Gadatliwość komunikatów na konsoli (ograniczona przez HP_POZIOM_LOGOW).
+     */
+    void ustaw_gadatliwosc(Gadatliwosc g) { gadatliwosc = g; }
+
+    /**
+     * Co ile kroków wypisywać postęp symulacji (0 - wcale).
+     */
+    void ustaw_interwal_raportu(int kroki) { interwal_raportu = kroki; }
+
+    /**
+     * Co ile kroków zapisywać klatkę do binarnej trajektorii trajektoria.bin.
+     */
+    void ustaw_krok_zapisu_trajektorii(int kroki) { krok_zapisu_trajektorii = kroki > 0 ? kroki : 1; }
+
+    /**
+     * Katalog, do którego algorytm_metropolisa zapisuje energia.txt,
+     * trajektoria.bin i koncowa_konformacja.txt (domyślnie bieżący).
+     */
+    void ustaw_katalog_wyjsciowy(const std::string& katalog) { katalog_wyjsciowy = katalog; }
+
+    /**
+     * Zachowanie zapisu w tle, gdy dysk nie nadąża (domyślnie Blokuj).
+     */
+    void ustaw_polityke_zapisu(ZapisAsynchroniczny::Polityka polityka) { polityka_zapisu = polityka; }
+
+    /**
+     * Punkty kontrolne algorytmu_metropolisa: co `co_ile` kroków pełny stan
+     * przebiegu (pozycje, temperatura, krok, statystyki, pamięć konformacji, stan generatora)
+     * zapisywany jest atomowo do pliku `sciezka` (co_ile = 0 - wyłączone).
+     */
+    void ustaw_punkty_kontrolne(const std::string& sciezka, long long co_ile) {
+        sciezka_punktu_kontrolnego = sciezka;
+        co_ile_punkt_kontrolny = co_ile;
+    }
+
+    /**
+     * Pamięć odwiedzonych konformacji dla algorytmu_metropolisa (nullptr - wyłączona).
+     * Każdy krok rejestruje bieżącą konformację (klucz kanoniczny, energia, krok),
+     * więc po przebiegu można policzyć różne minima bez zapisywania trajektorii.
+     * kara_tabu > 0 dodaje w kryterium akceptacji kara_tabu * liczba odwiedzin
+     * do energii stanu, kierując łańcuch ku rzadko odwiedzanym konformacjom
+     * (dywersyfikacja typu tabu; rozkład przestaje być boltzmannowski).
+     * Pamięć może być współdzielona przez kilka modeli. Trafia w całości do punktu kontrolnego,
+     * więc liczby konformacji po wznowieniu są takie jak w przebiegu bez przerwy.
+     */
+    void ustaw_pamiec_konformacji(PamiecKonformacji* pamiec, double kara_tabu = 0.0) {
+        pamiec_konformacji = pamiec;
+        this->kara_tabu = kara_tabu;
+    }
+
+    /**
+     * Wczytuje punkt kontrolny. Następne wywołanie algorytmu_metropolisa z tymi
+     * samymi parametrami kontynuuje przebieg od zapisanego kroku i dopisuje do
+     * plików wyjściowych; wynik jest identyczny jak przebiegu bez przerwy.
+     * Harmonogram, detektor zbieżności, statystyki i pamięć konformacji (o tej samej
+     * pojemności) muszą być ustawione tak samo jak przy zapisie (plik zapisuje, które były).
+     * Stan jest czytany do kopii, więc przy błędzie ani model, ani te obiekty się nie zmieniają.
+     * @return false, jeśli plik nie istnieje, jest uszkodzony, dotyczy innej sekwencji
+     *         albo innych ustawień sekcji opcjonalnych
+     */
+    bool wczytaj_punkt_kontrolny(const std::string& sciezka);
+
+    /**
+     * Telemetria ostatniego przebiegu (czas faz, kroki/s); pozwala ustawić próbkowanie.
+     */
+    Telemetria& get_telemetria() { return telemetria; }
+    const Telemetria& get_telemetria() const { return telemetria; }
+
+    /**
+     * Wypisuje statystyki ruchów i telemetrię po zakończeniu symulacji.
      */
     void wypisz_statystyki() const;
 
+    /**
+     * Zwraca sekwencję HP modelowanego białka.
+     */
+    const std::string& get_sekwencja() const { return sekwencja_bialka; }
+
     /**
      * Zwraca aktualne pozycje aminokwasów.
      */
     const std::vector<Vec3>& get_pozycje() const { return pozycje; }
+
+    /**
+     * Pełne przeliczenie energii w czasie O(N²).
+     * W pętli Metropolisa służy wyłącznie do kontroli spójności (HP_SPRAWDZ_ENERGIE).
+     */
     double oblicz_energie() const;
 
+    /**
+     * Przeliczenie energii z siatki zajętości w czasie O(N) (suma energii lokalnych).
+     */
+    int energia_z_siatki() const;
+
+    /**
+     * Zwraca bieżącą energię utrzymywaną przyrostowo (bez przeliczania).
+     */
+    double get_energia() const { return energia; }
+
     /**
      * Gettery do statystyk akceptowanych ruchów.
      */
     int get_zaakceptowane_koniec() const { return zaakceptowane_koniec; }
     int get_zaakceptowane_naroznik() const { return zaakceptowane_naroznik; }
     int get_zaakceptowane_crankshaft() const { return zaakceptowane_crankshaft; }
+    int get_zaakceptowane_pull() const { return zaakceptowane_pull; }
+
+    /**
+     * Ruch jako różnica: `liczba` kolejnych aminokwasów od `pierwszy`
+     * z ich starymi i nowymi węzłami. Stare węzły są zapisem do cofnięcia
+     * ruchu, więc nie trzeba kopiować całej konformacji.
+     * Do dwóch aminokwasów węzły są w samym ruchu; dłuższe pull moves
+     * trzymają je w buforach modelu (zob. stare_ruchu / nowe_ruchu).
+     */
+    struct Ruch {
+        int typ;            // 0 - koniec, 1 - narożnik, 2 - crankshaft, 3 - pull move
+        int liczba;         // liczba przesuniętych aminokwasów
+        size_t pierwszy;    // indeks pierwszego przesuniętego aminokwasu
+        Vec3 stare[2];
+        Vec3 nowe[2];
+    };
 
 private:
+    // Przemiata łańcuch w miejscu, na pozycjach i siatce modelu (bez drugiej kopii siatki)
+    friend class SzachownicaMC;
+
     std::string sekwencja_bialka;
-    std::unordered_map<Vec3, char> mapa_pozycji;
+    std::vector<uint8_t> kody;  // sekwencja zakodowana przez Oddzialywanie::koduj
+    SiatkaZajetosci siatka; // zajętość węzłów: indeks i typ aminokwasu (bit H)
     std::vector<Vec3> pozycje;
+    int energia; // bieżąca energia, aktualizowana o ΔE po każdym ruchu
+
+    TrybPropozycji tryb_propozycji;
+
+    // Komunikaty i pomiary wydajności
+    Gadatliwosc gadatliwosc;
+    int interwal_raportu;
+    int krok_zapisu_trajektorii;
+    std::string katalog_wyjsciowy;
+    ZapisAsynchroniczny::Polityka polityka_zapisu;
+    Telemetria telemetria;
+
+    // Punkty kontrolne i wznowienie przerwanego przebiegu
+    struct StanPrzebiegu {
+        long long krok;                 // następny krok algorytmu_metropolisa
+        double T;
+        uint64_t dlugosc_energii;       // długości plików wyjściowych w chwili zapisu
+        uint64_t dlugosc_trajektorii;
+    };
+    std::string sciezka_punktu_kontrolnego;
+    long long co_ile_punkt_kontrolny;
+    bool wznowienie;                    // przebieg wczytany z punktu kontrolnego
+    StanPrzebiegu przebieg;
+
+    // Pamięć odwiedzonych konformacji i bieżący stan w niej
+    PamiecKonformacji* pamiec_konformacji;
+    double kara_tabu;
+    KluczKonformacji klucz_biezacy;
+    uint32_t odwiedziny_biezace;
+
+    // Harmonogram temperatury, detektor zbieżności i najlepszy stan przebiegu
+    HarmonogramTemperatury* harmonogram;
+    DetektorZbieznosci* detektor;
+    StatystykiPrzebiegu* statystyki;
+    bool zapis_energii;
+    bool zapis_plikow;
+    int typ_ostatniego_ruchu;       // typ ruchu wylosowanego w ostatnim kroku
+    long long kroki_przebiegu;
+    int najlepsza_energia_przebiegu;
+    std::vector<Vec3> najlepsze_pozycje;
 
-    std::mt19937 gen;
-    std::uniform_int_distribution<> dist_os;
-    std::uniform_int_distribution<> dist_kierunek;
-    std::uniform_int_distribution<> dist_ruch;
+    // Bufor kandydatów wyliczanych przez ruchy; pojemność zostaje między krokami
+    std::vector<Ruch> kandydaci;
+
+    // Wariant pull move: aminokwas, strona ciągnięcia (+1/-1) i kierunki
+    struct WariantPull {
+        size_t i;
+        int strona;
+        int kierunek1, kierunek2;
+    };
+    std::vector<WariantPull> kandydaci_pull;
+
+    // Węzły przesuwane przez pull move dłuższy niż 2 aminokwasy (rozmiar N)
+    std::vector<Vec3> bufor_stare, bufor_nowe;
+
+    Xoshiro256 gen;
+    double mieszanka_ruchow[4];     // skumulowane wagi typów ruchu
+    TablicaAkceptacji tablica_akceptacji;
 
     // Statystyki ruchów w symulacji
     int proponowane_koniec, zaakceptowane_koniec;
     int proponowane_naroznik, zaakceptowane_naroznik;
     int proponowane_crankshaft, zaakceptowane_crankshaft;
-    int nieudane_koniec, nieudane_naroznik, nieudane_crankshaft;
+    int proponowane_pull, zaakceptowane_pull;
+    int nieudane_koniec, nieudane_naroznik, nieudane_crankshaft, nieudane_pull;
+    long long wykonane_kroki; // licznik kroków krok_mc (dopasowanie siatki)
+    double log_stosunek_propozycji; // poprawka Hastingsa ostatniej propozycji
 
     // Pomocnicze funkcje/model ruchów
     int odleglosc(const Vec3& a, const Vec3& b) const;
     bool pole_wolne(const Vec3& pos) const;
     bool sa_sasiadami(const Vec3& a, const Vec3& b) const; 
+    int energia_lokalna(size_t i) const;
+    int energia_przesunietych(const Ruch& ruch) const;
+    void zastosuj_ruch(const Ruch& ruch);
+    void cofnij_ruch(const Ruch& ruch);
+    bool zaproponuj_ruch(Ruch& ruch, int& typ_ruchu, int& dE, bool mierz);
+    void zakoncz_ruch(const Ruch& ruch, int typ_ruchu, int dE, bool akceptacja, bool mierz);
+    void po_kroku();
+    bool akceptuj_metropolis(int dE, double log_stosunek, double T);
+    bool krok_z_pamiecia(double T, long long numer_kroku, bool mierz);
+    bool zapisz_punkt_kontrolny(const StanPrzebiegu& stan) const;
+    void odbuduj_siatke();
+    const Vec3* stare_ruchu(const Ruch& ruch) const { return ruch.liczba > 2 ? bufor_stare.data() : ruch.stare; }
+    const Vec3* nowe_ruchu(const Ruch& ruch) const { return ruch.liczba > 2 ? bufor_nowe.data() : ruch.nowe; }
+    bool pull_legalny(const WariantPull& wariant, Vec3& L, Vec3& C) const;
+    void zbuduj_pull(const WariantPull& wariant, const Vec3& L, const Vec3& C, Ruch& ruch);
 
-    std::vector<Vec3> ruch_przesun_koniec();
-    std::vector<Vec3> ruch_obrot_naroznika();
-    std::vector<Vec3> ruch_crankshaft();
+    // Ruchy: losują jeden z możliwych ruchów danego typu; false - brak ruchu
+    bool ruch_przesun_koniec(Ruch& ruch);
+    bool ruch_obrot_naroznika(Ruch& ruch);
+    bool ruch_crankshaft(Ruch& ruch);
+    bool ruch_pull(Ruch& ruch);
+
+    // Ruchy lokalne: jedna losowa propozycja danego typu; false - propozycja nielegalna
+    bool lokalny_przesun_koniec(Ruch& ruch);
+    bool lokalny_obrot_naroznika(Ruch& ruch);
+    bool lokalny_crankshaft(Ruch& ruch);
+    bool lokalny_pull(Ruch& ruch);
 };
+
+using HP_model = Model<OddzialywanieHP>;
+using HPNX_model = Model<OddzialywanieHPNX>;
+using MJ_model = Model<OddzialywanieMJ>;
+
+extern template class Model<OddzialywanieHP>;
+extern template class Model<OddzialywanieHPNX>;
+extern template class Model<OddzialywanieMJ>;
@@ -0,0 +1,162 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include "PunktKontrolny.h"
+
+/**
+ * Opis wykonanego kroku wyżarzania przekazywany harmonogramowi i detektorowi zbieżności.
+ */
+struct KrokWyzarzania {
+    long long numer;
+    int energia;            // energia po kroku
+    int zmiana_energii;     // ΔE kroku (0 także dla ruchów neutralnych energetycznie)
+    bool zaakceptowano;
+};
+
+/**
+ * Klasa HarmonogramTemperatury: wymienna polityka zmiany temperatury
+ * w algorytmie_metropolisa (zob. HP_model::ustaw_harmonogram).
+ * Stan wewnętrzny jest zapisywany w punkcie kontrolnym, więc wznowiony
+ * przebieg prowadzi temperaturę dokładnie tak samo jak nieprzerwany.
+ *
+ * odczytaj_stan (tu i w innych stanach punktu kontrolnego) czyta stan do kopii,
+ * nie zmieniając obiektu, i zwraca funkcję, która go ustawia - wywoływaną dopiero
+ * po poprawnym odczycie całego pliku.
+ */
+class HarmonogramTemperatury {
+public:
+    virtual ~HarmonogramTemperatury() = default;
+
+    /**
+     * Początek przebiegu (także po restarcie) w temperaturze T0.
+     */
+    virtual void rozpocznij(double T0) = 0;
+
+    /**
+     * Temperatura następnego kroku po kroku `krok` wykonanym w temperaturze T.
+     */
+    virtual double nastepna(double T, const KrokWyzarzania& krok) = 0;
+
+    /**
+     * Nazwa rodzaju harmonogramu zapisywana w punkcie kontrolnym (wznowienie wymaga tego samego).
+     */
+    virtual const char* rodzaj() const = 0;
+
+    virtual void zapisz_stan(ZapisBinarny&) const {}
+    virtual std::function<void()> odczytaj_stan(OdczytBinarny&) { return [] {}; }
+};
+
+/**
+ * Chłodzenie geometryczne T = max(alpha * T, T_inf) - domyślne zachowanie algorytmu_metropolisa.
+ */
+class HarmonogramGeometryczny : public HarmonogramTemperatury {
+public:
+    HarmonogramGeometryczny(double alpha, double T_inf) : alpha(alpha), T_inf(T_inf) {}
+
+    void rozpocznij(double) override {}
+    double nastepna(double T, const KrokWyzarzania&) override { return std::max(alpha * T, T_inf); }
+    const char* rodzaj() const override { return "geometryczny"; }
+
+private:
+    double alpha, T_inf;
+};
+
+/**
+ * Chłodzenie sterowane akceptacją: co `okno` kroków mierzony jest ułamek a kroków
+ * zaakceptowanych ze zmianą energii, a w kolejnym oknie temperatura maleje o czynnik
+ * alpha^(a / cel_akceptacji) (wykładnik ograniczony do [1/4, 4]). Ruchy neutralne
+ * (np. końców łańcucha) nie są liczone, bo przyjmowane są w każdej temperaturze.
+ * W fazie "ciekłej" chłodzenie jest szybkie, a przy zamarzaniu zwalnia, więc kroki
+ * trafiają w zakres temperatur, w którym łańcuch jeszcze się przebudowuje.
+ */
+class HarmonogramAdaptacyjny : public HarmonogramTemperatury {
+public:
+    HarmonogramAdaptacyjny(double alpha, double T_inf, double cel_akceptacji = 0.05, long long okno = 1000);
+
+    void rozpocznij(double T0) override;
+    double nastepna(double T, const KrokWyzarzania& krok) override;
+    const char* rodzaj() const override { return "adaptacyjny"; }
+    void zapisz_stan(ZapisBinarny& zapis) const override;
+    std::function<void()> odczytaj_stan(OdczytBinarny& odczyt) override;
+
+private:
+    double alpha, T_inf, cel_akceptacji;
+    long long okno;
+    double czynnik;             // mnożnik temperatury w bieżącym oknie
+    long long kroki_w_oknie, zaakceptowane_w_oknie;
+};
+
+/**
+ * Chłodzenie geometryczne z podgrzewaniem: gdy najlepsza energia nie poprawia się
+ * przez `cierpliwosc` kroków, temperatura wraca do ulamek_T0 * T0
+ * (najwyżej maks_podgrzan razy), co pozwala wyjść z pułapki bez utraty postępu.
+ */
+class HarmonogramZPodgrzewaniem : public HarmonogramTemperatury {
+public:
+    HarmonogramZPodgrzewaniem(double alpha, double T_inf, long long cierpliwosc,
+                              double ulamek_T0 = 0.5, int maks_podgrzan = 10);
+
+    void rozpocznij(double T0) override;
+    double nastepna(double T, const KrokWyzarzania& krok) override;
+    const char* rodzaj() const override { return "z_podgrzewaniem"; }
+    void zapisz_stan(ZapisBinarny& zapis) const override;
+    std::function<void()> odczytaj_stan(OdczytBinarny& odczyt) override;
+
+    int get_podgrzania() const { return podgrzania; }
+
+private:
+    double alpha, T_inf, ulamek_T0;
+    long long cierpliwosc;
+    int maks_podgrzan;
+    double T_startowa;
+    int najlepsza;
+    long long bez_poprawy;
+    int podgrzania;
+};
+
+/**
+ * Ustawienia detektora zbieżności.
+ */
+struct UstawieniaZbieznosci {
+    long long okno_plateau = 100000;    // kroki bez poprawy najlepszej energii
+    long long okno_akceptacji = 10000;  // kroki, z których liczona jest akceptacja
+    double prog_akceptacji = 0.01;      // akceptacja (ze zmianą energii) poniżej progu - łańcuch zamarznięty
+    int maks_restartow = 0;             // restarty przed zakończeniem przebiegu
+};
+
+/**
+ * Klasa DetektorZbieznosci: kończy lub restartuje przebieg, który przestał robić postęp.
+ * Przebieg uznawany jest za zbieżny, gdy najlepsza energia (od początku lub
+ * ostatniego restartu) nie poprawiła się przez okno_plateau kroków, a ułamek kroków
+ * zmieniających energię w ostatnim pełnym oknie spadł poniżej prog_akceptacji
+ * (ruchy neutralne są akceptowane także w zamarzniętym łańcuchu). Wtedy detektor
+ * zleca restart (nowa losowa konformacja, T = T0), a po maks_restartow - zakończenie.
+ */
+class DetektorZbieznosci {
+public:
+    enum class Decyzja { Kontynuuj, Restart, Zakoncz };
+
+    explicit DetektorZbieznosci(const UstawieniaZbieznosci& ustawienia);
+
+    /**
+     * Początek przebiegu: zeruje także licznik restartów.
+     */
+    void rozpocznij();
+
+    Decyzja obserwuj(const KrokWyzarzania& krok);
+
+    int get_restarty() const { return restarty; }
+
+    void zapisz_stan(ZapisBinarny& zapis) const;
+    std::function<void()> odczytaj_stan(OdczytBinarny& odczyt);
+
+private:
+    UstawieniaZbieznosci ustawienia;
+    int najlepsza;
+    long long bez_poprawy;
+    long long kroki_w_oknie, zaakceptowane_w_oknie;
+    double akceptacja;          // akceptacja w ostatnim pełnym oknie
+    int restarty;
+
+    void rozpocznij_odcinek();
+};
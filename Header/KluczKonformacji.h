@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Vec3.h"
+
+/**
+ * 128-bitowy klucz konformacji niezależny od położenia i orientacji łańcucha.
+ * Wiązania kodowane są jako kierunki (indeks w KIERUNKI), a następnie
+ * sprowadzane do postaci kanonicznej względem 48 symetrii siatki sześciennej:
+ * osie i zwroty numerowane są w kolejności pierwszego wystąpienia, więc pierwsze
+ * wiązanie to zawsze +x, pierwsze wiązanie poza osią x to +y, a pierwsze poza
+ * płaszczyzną xy to +z (najmniejszy leksykograficznie ciąg kodów spośród 48 obrazów).
+ * Do 44 aminokwasów klucz jest dokładny (3 bity na wiązanie, bez pierwszego),
+ * dla dłuższych łańcuchów to 128-bitowy skrót ciągu kanonicznego.
+ */
+struct KluczKonformacji {
+    uint64_t a, b;
+
+    bool operator==(const KluczKonformacji& inny) const { return a == inny.a && b == inny.b; }
+    bool operator!=(const KluczKonformacji& inny) const { return !(*this == inny); }
+};
+
+/**
+ * Klucz kanoniczny konformacji (O(N), bez alokacji).
+ */
+KluczKonformacji klucz_konformacji(const std::vector<Vec3>& pozycje);
+
+namespace std {
+    template <>
+    struct hash<KluczKonformacji> {
+        // Dokładne klucze krótkich łańcuchów nie są losowe (b = 0, niskie bity to
+        // pierwsze wiązania), więc obie połowy przechodzą przez finalizator splitmix64
+        std::size_t operator()(const KluczKonformacji& k) const {
+            uint64_t z = k.a ^ (k.b * 0x9E3779B97F4A7C15ULL + 0x632BE59BD9B4E019ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return static_cast<std::size_t>(z ^ (z >> 31));
+        }
+    };
+}
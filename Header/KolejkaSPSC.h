@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Bezblokadowa kolejka jeden producent / jeden konsument o stałej pojemności.
+ * Pojemność zaokrąglana jest w górę do potęgi dwójki; pamięć przydzielana raz.
+ */
+template <typename T>
+class KolejkaSPSC {
+public:
+    explicit KolejkaSPSC(size_t pojemnosc) : glowa(0), ogon(0) {
+        size_t rozmiar = 1;
+        while (rozmiar < pojemnosc) rozmiar <<= 1;
+        elementy.resize(rozmiar);
+        maska = rozmiar - 1;
+    }
+
+    /**
+     * Wstawia element (wątek producenta). @return false, jeśli kolejka jest pełna.
+     */
+    bool wstaw(const T& element) {
+        size_t g = glowa.load(std::memory_order_relaxed);
+        if (g - ogon.load(std::memory_order_acquire) > maska) return false;
+        elementy[g & maska] = element;
+        glowa.store(g + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Pobiera element (wątek konsumenta). @return false, jeśli kolejka jest pusta.
+     */
+    bool pobierz(T& element) {
+        size_t o = ogon.load(std::memory_order_relaxed);
+        if (o == glowa.load(std::memory_order_acquire)) return false;
+        element = elementy[o & maska];
+        ogon.store(o + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Przybliżona liczba elementów (dokładna dla wywołującego producenta lub konsumenta).
+     */
+    size_t rozmiar() const {
+        return glowa.load(std::memory_order_acquire) - ogon.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> elementy;
+    size_t maska;
+    // Osobne linie pamięci podręcznej dla indeksów producenta i konsumenta
+    alignas(64) std::atomic<size_t> glowa;
+    alignas(64) std::atomic<size_t> ogon;
+};
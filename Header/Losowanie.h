@@ -0,0 +1,147 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Klasa Xoshiro256: generator xoshiro256** (Blackman, Vigna).
+ * 256 bitów stanu, okres 2^256 - 1; spełnia wymagania UniformRandomBitGenerator.
+ * Niezależne strumienie (łańcuchy, repliki, wątki) uzyskuje się skokiem o 2^128
+ * kroków - strumień k zaczyna się k skoków od stanu wyznaczonego przez ziarno,
+ * więc strumienie nie nakładają się.
+ */
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t ziarno = 0) { ustaw_ziarno(ziarno); }
+
+    /**
+     * Stan początkowy z 64-bitowego ziarna rozwiniętego przez splitmix64.
+     */
+    void ustaw_ziarno(uint64_t ziarno) {
+        for (auto& slowo : s) {
+            ziarno += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = ziarno;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            slowo = z ^ (z >> 31);
+        }
+    }
+
+    /**
+     * Strumień numer `numer` dla danego ziarna (numer skoków o 2^128).
+     */
+    static Xoshiro256 strumien(uint64_t ziarno, uint64_t numer) {
+        Xoshiro256 gen(ziarno);
+        for (uint64_t k = 0; k < numer; ++k) gen.skok();
+        return gen;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const uint64_t wynik = rotl(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return wynik;
+    }
+
+    /**
+     * Liczba całkowita jednostajna w [0, n), n > 0 (metoda Lemire'a:
+     * jedno mnożenie, dzielenie tylko w rzadkim przypadku odrzucenia).
+     */
+    uint32_t ponizej(uint32_t n) {
+        uint64_t m = ((*this)() >> 32) * n;
+        uint32_t reszta = static_cast<uint32_t>(m);
+        if (reszta < n) {
+            const uint32_t prog = static_cast<uint32_t>(-n) % n;
+            while (reszta < prog) {
+                m = ((*this)() >> 32) * n;
+                reszta = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+
+    /**
+     * Liczba zmiennoprzecinkowa jednostajna w [0, 1) (53 bity).
+     */
+    double jednostajna() { return static_cast<double>((*this)() >> 11) * 0x1.0p-53; }
+
+    /**
+     * Skok o 2^128 kroków.
+     */
+    void skok() {
+        static const uint64_t SKOK[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                         0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        uint64_t t[4] = {0, 0, 0, 0};
+        for (uint64_t maska : SKOK) {
+            for (int b = 0; b < 64; ++b) {
+                if (maska & (1ULL << b)) {
+                    for (int k = 0; k < 4; ++k) t[k] ^= s[k];
+                }
+                (*this)();
+            }
+        }
+        for (int k = 0; k < 4; ++k) s[k] = t[k];
+    }
+
+    /**
+     * Pełny stan (np. do punktu kontrolnego).
+     */
+    uint64_t stan(int k) const { return s[k]; }
+    void ustaw_stan(int k, uint64_t wartosc) { s[k] = wartosc; }
+
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+/**
+ * Klasa TablicaAkceptacji: progi akceptacji Metropolisa dla całkowitych ΔE > 0.
+ * Ruch jest przyjmowany, gdy losowe 64 bity < prog(ΔE, T) = exp(-ΔE/T) * 2^64,
+ * więc w pętli nie ma exp ani liczb zmiennoprzecinkowych.
+ * Wpis wyliczany jest przy pierwszym użyciu w danej temperaturze i ważny do zmiany T;
+ * przy stałym T (faza T_inf, wymiana replik) exp nie jest liczony wcale,
+ * a podczas chłodzenia - najwyżej raz na krok, jak bez tablicy.
+ */
+class TablicaAkceptacji {
+public:
+    static constexpr int ROZMIAR = 64;  // większe ΔE liczone bezpośrednio
+
+    TablicaAkceptacji() : temperatura(std::numeric_limits<double>::quiet_NaN()), pokolenie(1) {
+        for (auto& p : pokolenie_wpisu) p = 0;
+    }
+
+    uint64_t prog(int dE, double T) {
+        if (T != temperatura) {
+            temperatura = T;
+            ++pokolenie;
+        }
+        if (dE >= ROZMIAR) return prog_dokladny(dE, T);
+        if (pokolenie_wpisu[dE] != pokolenie) {
+            progi[dE] = prog_dokladny(dE, T);
+            pokolenie_wpisu[dE] = pokolenie;
+        }
+        return progi[dE];
+    }
+
+private:
+    double temperatura;
+    uint64_t pokolenie;
+    uint64_t pokolenie_wpisu[ROZMIAR];
+    uint64_t progi[ROZMIAR];
+
+    static uint64_t prog_dokladny(int dE, double T) {
+        const double p = std::exp(-dE / T);
+        return p < 1.0 ? static_cast<uint64_t>(std::ldexp(p, 64)) : std::numeric_limits<uint64_t>::max();
+    }
+};
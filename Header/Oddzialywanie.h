@@ -0,0 +1,124 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+/**
+ * Polityki oddziaływań kontaktowych dla Model<O> (zob. HP_model.h), wybierane w czasie
+ * kompilacji. Sekwencja kodowana jest raz, przy tworzeniu modelu, jako małe liczby
+ * całkowite, a energia kontaktu to odczyt tablicy constexpr - bez wywołań wirtualnych
+ * i wyszukiwania w mapie w pętli kroku.
+ *
+ * Polityka dostarcza:
+ *  - LICZBA_TYPOW - rozmiar alfabetu,
+ *  - koduj(litera) - kod 0..LICZBA_TYPOW-1 albo -1 dla litery spoza alfabetu,
+ *  - energia(a, b) - energia niesąsiedniego kontaktu typów a i b (symetryczna, całkowita),
+ *  - oddzialuje(a) - czy typ a ma choć jeden niezerowy kontakt,
+ *  - MASKA_HH - true tylko dla czystego modelu HP: typ siedzi w bicie komórki
+ *    SiatkaZajetosci, więc kontakt sprawdza się bez odczytu sekwencji.
+ *
+ * Energie są całkowite, w jednostkach polityki (np. 0.01 kT dla macierzy przeskalowanej
+ * przez 100); temperatury podaje się w tych samych jednostkach.
+ */
+struct OddzialywanieHP {
+    static constexpr int LICZBA_TYPOW = 2;
+    static constexpr bool MASKA_HH = true;
+
+    // Jak dotąd: każda litera poza H zachowuje się jak P
+    static constexpr int koduj(char litera) { return litera == 'H' ? 1 : 0; }
+    static constexpr int energia(uint8_t a, uint8_t b) { return -(a & b); }
+    static constexpr bool oddzialuje(uint8_t a) { return a != 0; }
+};
+
+/**
+ * Oddziaływania z macierzy K x K podanej w czasie kompilacji. Tabela to typ z polami
+ *   static constexpr char LITERY[] = "...";      // K liter alfabetu
+ *   static constexpr int ENERGIE[K][K] = {...};   // macierz symetryczna
+ * Model 20 aminokwasów dostarcza TabelaMJ (poniżej).
+ * Nowa tabela wymaga jawnej instancji Model<OddzialywanieMacierz<Tabela>> w HP_model.cpp.
+ */
+template <typename Tabela>
+struct OddzialywanieMacierz {
+    static constexpr int LICZBA_TYPOW = static_cast<int>(sizeof(Tabela::LITERY)) - 1;
+    static constexpr bool MASKA_HH = false;
+    static_assert(LICZBA_TYPOW > 0 && LICZBA_TYPOW < 256, "Alfabet musi mieć od 1 do 255 liter");
+
+    static constexpr int koduj(char litera) {
+        for (int k = 0; k < LICZBA_TYPOW; ++k) {
+            if (Tabela::LITERY[k] == litera) return k;
+        }
+        return -1;
+    }
+    static constexpr int energia(uint8_t a, uint8_t b) { return Tabela::ENERGIE[a][b]; }
+    static constexpr bool oddzialuje(uint8_t a) { return AKTYWNE[a]; }
+
+private:
+    static constexpr std::array<bool, LICZBA_TYPOW> AKTYWNE = [] {
+        std::array<bool, LICZBA_TYPOW> aktywne{};
+        for (int a = 0; a < LICZBA_TYPOW; ++a) {
+            for (int b = 0; b < LICZBA_TYPOW; ++b) {
+                if (Tabela::ENERGIE[a][b] != 0) aktywne[a] = true;
+            }
+        }
+        return aktywne;
+    }();
+
+    static_assert([] {
+        for (int a = 0; a < LICZBA_TYPOW; ++a) {
+            for (int b = 0; b < a; ++b) {
+                if (Tabela::ENERGIE[a][b] != Tabela::ENERGIE[b][a]) return false;
+            }
+        }
+        return true;
+    }(), "Macierz energii kontaktu musi być symetryczna");
+};
+
+/**
+ * Model HPNX (Blackburne, Hirst): H - hydrofobowy, P i N - polarne naładowane
+ * dodatnio i ujemnie, X - obojętny. H-H -4, P-P i N-N +1, P-N -1, pozostałe 0.
+ */
+struct TabelaHPNX {
+    static constexpr char LITERY[] = "HPNX";
+    static constexpr int ENERGIE[4][4] = {
+        // H   P   N   X
+        {-4,  0,  0,  0},   // H
+        { 0,  1, -1,  0},   // P
+        { 0, -1,  1,  0},   // N
+        { 0,  0,  0,  0}    // X
+    };
+};
+using OddzialywanieHPNX = OddzialywanieMacierz<TabelaHPNX>;
+
+/**
+ * Model 20 aminokwasów z energiami kontaktu Miyazawy-Jernigana (Macromolecules 1985;
+ * J. Mol. Biol. 1996, tabela 3, e_ij w jednostkach RT), przeskalowanymi przez 100 i
+ * zaokrąglonymi do liczb całkowitych - energia jest więc w 0.01 RT, a temperatury
+ * podaje się w tych samych jednostkach (T = 100 odpowiada RT). Litery w kolejności tabeli.
+ */
+struct TabelaMJ {
+    static constexpr char LITERY[] = "CMFILVWYAGTSNQDEHRKP";
+    static constexpr int SKALA = 100;
+    static constexpr int ENERGIE[20][20] = {
+        //      C     M     F     I     L     V     W     Y     A     G     T     S     N     Q     D     E     H     R     K     P
+        { -544, -499, -580, -550, -583, -496, -495, -416, -357, -316, -311, -286, -259, -285, -241, -227, -360, -257, -195, -307},   // C
+        { -499, -546, -656, -602, -641, -532, -555, -491, -394, -339, -351, -303, -295, -330, -257, -289, -398, -312, -248, -345},   // M
+        { -580, -656, -726, -684, -728, -629, -616, -566, -481, -413, -428, -402, -375, -410, -348, -356, -477, -398, -336, -425},   // F
+        { -550, -602, -684, -654, -704, -605, -578, -525, -458, -378, -403, -352, -324, -367, -317, -327, -414, -363, -301, -376},   // I
+        { -583, -641, -728, -704, -737, -648, -614, -567, -491, -416, -434, -392, -374, -404, -340, -359, -454, -403, -337, -420},   // L
+        { -496, -532, -629, -605, -648, -552, -518, -462, -404, -338, -346, -305, -283, -307, -248, -267, -358, -307, -249, -332},   // V
+        { -495, -555, -616, -578, -614, -518, -506, -466, -382, -342, -322, -299, -307, -311, -284, -299, -398, -341, -269, -373},   // W
+        { -416, -491, -566, -525, -567, -462, -466, -417, -336, -301, -301, -278, -276, -297, -276, -279, -352, -316, -260, -319},   // Y
+        { -357, -394, -481, -458, -491, -404, -382, -336, -272, -231, -232, -201, -184, -189, -170, -151, -241, -183, -131, -203},   // A
+        { -316, -339, -413, -378, -416, -338, -342, -301, -231, -224, -208, -182, -174, -166, -159, -122, -215, -172, -115, -187},   // G
+        { -311, -351, -428, -403, -434, -346, -322, -301, -232, -208, -212, -196, -188, -190, -180, -174, -242, -190, -131, -190},   // T
+        { -286, -303, -402, -352, -392, -305, -299, -278, -201, -182, -196, -167, -158, -149, -163, -148, -211, -162, -105, -157},   // S
+        { -259, -295, -375, -324, -374, -283, -307, -276, -184, -174, -188, -158, -168, -171, -168, -151, -208, -164, -121, -153},   // N
+        { -285, -330, -410, -367, -404, -307, -311, -297, -189, -166, -190, -149, -171, -154, -146, -142, -198, -180, -129, -173},   // Q
+        { -241, -257, -348, -317, -340, -248, -284, -276, -170, -159, -180, -163, -168, -146, -121, -102, -232, -229, -168, -133},   // D
+        { -227, -289, -356, -327, -359, -267, -299, -279, -151, -122, -174, -148, -151, -142, -102,  -91, -215, -227, -180, -126},   // E
+        { -360, -398, -477, -414, -454, -358, -398, -352, -241, -215, -242, -211, -208, -198, -232, -215, -305, -216, -135, -225},   // H
+        { -257, -312, -398, -363, -403, -307, -341, -316, -183, -172, -190, -162, -164, -180, -229, -227, -216, -155,  -59, -170},   // R
+        { -195, -248, -336, -301, -337, -249, -269, -260, -131, -115, -131, -105, -121, -129, -168, -180, -135,  -59,  -12,  -97},   // K
+        { -307, -345, -425, -376, -420, -332, -373, -319, -203, -187, -190, -157, -153, -173, -133, -126, -225, -170,  -97, -175}    // P
+    };
+};
+using OddzialywanieMJ = OddzialywanieMacierz<TabelaMJ>;
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Vec3.h"
+#include "Siatka.h"
+#include "Losowanie.h"
+
+/**
+ * Ustawienia algorytmu PERM.
+ */
+struct UstawieniaPERM {
+    double T = 0.3;                     // temperatura wag Boltzmanna
+    double C = 1.0;                     // próg wzbogacania W+ = C * Z_n
+    double prog_przycinania = 0.2;      // próg przycinania W- = prog_przycinania * W+
+    size_t maks_populacja = 100000;     // limit gałęzi czekających na stosie (pamięć)
+    long long maks_tur = 1000000;       // limit tur (wzrostów od pierwszego aminokwasu)
+    long long maks_wezlow = 100000000;  // limit dołożonych aminokwasów (czas)
+    int energia_docelowa = 0;           // zatrzymanie po osiągnięciu (0 - bez celu)
+    uint64_t ziarno = 0;
+};
+
+/**
+ * Klasa PERM: wzrost łańcucha metodą pruned-enriched Rosenbluth (nPERMis).
+ * Łańcuch rośnie aminokwas po aminokwasie w głąb (jawny stos gałęzi).
+ * Kandydat na następny węzeł losowany jest z wagą
+ * q = (wolni sąsiedzi + 1/2) * exp(-ΔE / T) (importance sampling z podglądem).
+ * Gałęzie o dużej wadze są wzbogacane - kontynuowane w kilku różnych
+ * kierunkach (bez powtórzeń, "nPERMis"), a o małej - przycinane z
+ * prawdopodobieństwem 1/2 (ocalałe mają podwójną wagę).
+ * Progi wyznacza bieżące oszacowanie sumy statystycznej Z_n dla każdej długości.
+ * Wagi przechowywane są jako logarytmy, więc nie przepełniają się dla długich łańcuchów.
+ */
+class PERM {
+public:
+    PERM(const std::string& sekwencja, const UstawieniaPERM& ustawienia);
+
+    /**
+     * Uruchamia przeszukiwanie do wyczerpania limitów lub osiągnięcia celu.
+     * @return true jeśli wyrósł co najmniej jeden pełny łańcuch
+     */
+    bool uruchom();
+
+    /**
+     * Zapisuje najlepszą konformację w formacie koncowa_konformacja.txt.
+     */
+    bool zapisz_konformacje(const std::string& sciezka) const;
+
+    /**
+     * Wypisuje liczbę tur, dołożonych aminokwasów, pełnych łańcuchów i najlepszą energię.
+     */
+    void wypisz_statystyki(std::ostream& out) const;
+
+    int get_najlepsza_energia() const { return najlepsza_energia; }
+    const std::vector<Vec3>& get_najlepsza_konformacja() const { return najlepsza_konformacja; }
+    long long get_tury() const { return tury; }
+    long long get_wezly() const { return wezly; }
+    double get_czas() const { return czas; }
+
+private:
+    // Gałąź czekająca na stosie: aminokwas `dlugosc - 1` w węźle `pozycja`
+    struct Galaz {
+        int dlugosc;
+        Vec3 pozycja;
+        double log_waga;
+        int energia;
+    };
+
+    // Kandydat na następny węzeł łańcucha
+    struct Kandydat {
+        Vec3 pozycja;
+        int dE;
+        double q;
+    };
+
+    std::string sekwencja;
+    UstawieniaPERM ustawienia;
+    Xoshiro256 gen;
+
+    SiatkaZajetosci siatka;
+    std::vector<Vec3> lancuch;   // bieżący prefiks łańcucha
+    std::vector<Galaz> stos;
+    std::vector<double> log_suma_wag;  // log sumy wag łańcuchów danej długości (Z_n * tury)
+    std::vector<double> liczba_lancuchow; // c_n: liczba utworzonych łańcuchów danej długości
+    double czynnik_boltzmanna[7];  // exp(k / T) dla k kontaktów nowego aminokwasu
+
+    int najlepsza_energia;
+    std::vector<Vec3> najlepsza_konformacja;
+    long long tury, wezly, pelne;
+    size_t maks_stos;
+    double czas;
+
+    void dodaj_wage(int dlugosc, double log_waga);
+    void cofnij_do(int dlugosc);
+    void rozwin(int energia, double log_waga);
+};
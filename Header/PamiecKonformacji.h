@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "KluczKonformacji.h"
+#include "PunktKontrolny.h"
+
+/**
+ * Dane zapamiętane dla odwiedzonej konformacji.
+ */
+struct WpisKonformacji {
+    int energia;
+    uint32_t odwiedziny;
+    long long pierwszy_krok;
+};
+
+/**
+ * Klasa PamiecKonformacji: ograniczona pamięć odwiedzonych konformacji
+ * (klucz kanoniczny -> energia, liczba odwiedzin, krok pierwszego odwiedzenia).
+ *
+ * Tablica jest podzielona na segmenty z osobnym mutexem, więc może być
+ * współdzielona przez wiele łańcuchów (np. repliki) bez wspólnej blokady.
+ * Każdy klucz ma w segmencie koszyk o ZBIEZNOSC miejscach; gdy koszyk jest pełny,
+ * wypierany jest wpis o najwyższej energii (przy remisie - najrzadziej odwiedzany),
+ * dzięki czemu konformacje niskoenergetyczne pozostają w pamięci najdłużej.
+ * Zużycie pamięci nie przekracza pojemności podanej w konstruktorze.
+ */
+class PamiecKonformacji {
+public:
+    static constexpr size_t ZBIEZNOSC = 8;
+
+    /**
+     * @param pojemnosc maksymalna liczba wpisów (zaokrąglana w górę do pełnych koszyków)
+     * @param liczba_segmentow liczba niezależnie blokowanych segmentów
+     */
+    explicit PamiecKonformacji(size_t pojemnosc, size_t liczba_segmentow = 64);
+
+    /**
+     * Rejestruje odwiedziny konformacji: zwiększa licznik lub wstawia nowy wpis.
+     * Zwraca stan wpisu po odwiedzinach.
+     */
+    WpisKonformacji odwiedz(const KluczKonformacji& klucz, int energia, long long krok);
+
+    /**
+     * Wyszukuje wpis bez jego zmiany.
+     */
+    bool znajdz(const KluczKonformacji& klucz, WpisKonformacji& wpis) const;
+
+    /**
+     * Liczba różnych konformacji o energii <= energia_maks obecnych w pamięci.
+     */
+    size_t zlicz_konformacje(int energia_maks) const;
+
+    /**
+     * Najniższa zapamiętana energia (0, gdy pamięć jest pusta).
+     */
+    int najnizsza_energia() const;
+
+    size_t rozmiar() const;
+    size_t get_pojemnosc() const { return segmenty.size() * koszyki_w_segmencie * ZBIEZNOSC; }
+    uint64_t get_wyparcia() const;
+
+    void wyczysc();
+
+    /**
+     * Stan do punktu kontrolnego: zajęte miejsca wszystkich segmentów (z położeniem
+     * w koszyku, więc kolejność wypierania po wznowieniu jest ta sama).
+     * odczytaj_stan nie zmienia pamięci (jak w HarmonogramTemperatury) i wymaga tej
+     * samej pojemności i liczby segmentów; przy niezgodności zwraca pustą funkcję.
+     */
+    void zapisz_stan(ZapisBinarny& zapis) const;
+    std::function<void()> odczytaj_stan(OdczytBinarny& odczyt);
+
+private:
+    struct Miejsce {
+        KluczKonformacji klucz;
+        WpisKonformacji wpis;
+        bool zajete;
+    };
+
+    struct Segment {
+        mutable std::mutex mutex;
+        std::vector<Miejsce> miejsca;
+        size_t zajete = 0;
+        uint64_t wyparcia = 0;
+    };
+
+    std::vector<std::unique_ptr<Segment>> segmenty;
+    size_t koszyki_w_segmencie;
+
+    // Segment klucza i indeks pierwszego miejsca jego koszyka
+    Segment& znajdz_koszyk(const KluczKonformacji& klucz, size_t& poczatek) const;
+};
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Harmonogram.h"
+#include "StatystykiPrzebiegu.h"
+
+// Struktura do przechowywania parametrów symulacji
+struct ParametrSymulacji {
+    double T0;           // temperatura początkowa
+    double T_inf;        // temperatura końcowa
+    double alpha;        // współczynnik chłodzenia
+    int kroki;           // liczba kroków
+    bool losowa_init;    // sposób inicjalizacji (true = losowa, false = linia prosta)
+
+    // Konstruktor
+    ParametrSymulacji(double t0, double t_inf, double a, int k, bool los)
+        : T0(t0), T_inf(t_inf), alpha(a), kroki(k), losowa_init(los) {}
+};
+
+// Wynik pojedynczego przebiegu przeglądu parametrów
+struct WynikPrzebiegu {
+    ParametrSymulacji params;
+    int powtorzenie;
+    uint64_t ziarno;
+    std::string katalog;   // katalog z plikami wynikowymi przebiegu
+    bool sukces;           // false - nie udało się wygenerować konformacji startowej
+    double energia;
+    int akceptowane_koniec;
+    int akceptowane_naroznik;
+    int akceptowane_crankshaft;
+    int akceptowane_pull;
+    long long wykonane_kroki;  // mniej niż params.kroki po wczesnym zakończeniu
+    StatystykiPrzebiegu statystyki;
+};
+
+/**
+ * Ziarno przebiegu o danym numerze, wyznaczone deterministycznie z ziarna bazowego
+ * (splitmix64), więc każdy przebieg przeglądu można powtórzyć osobno.
+ */
+uint64_t ziarno_przebiegu(uint64_t ziarno_bazowe, uint64_t numer);
+
+/**
+ * Równoległy przegląd parametrów: każdy zestaw z `siatka` uruchamiany jest
+ * `powtorzenia` razy na puli wątków z podkradaniem zadań.
+ * Przebieg o numerze i * powtorzenia + r zapisuje pliki do katalog_bazowy/przebieg_<numer>
+ * i używa ziarna ziarno_przebiegu(ziarno_bazowe, numer). Energia przebiegów
+ * nie jest zapisywana krok po kroku - zastępują ją statystyki w wyniku i statystyki.txt.
+ * @param watki liczba wątków (0 - liczba rdzeni)
+ * @param zbieznosc ustawienia detektora zbieżności (nullptr - pełna liczba kroków);
+ *        każdy przebieg dostaje własny detektor
+ * @return wyniki w kolejności numerów przebiegów, niezależnie od kolejności wykonania
+ */
+std::vector<WynikPrzebiegu> przeprowadz_przeglad(const std::vector<ParametrSymulacji>& siatka,
+                                                 int powtorzenia, uint64_t ziarno_bazowe,
+                                                 const std::string& katalog_bazowy,
+                                                 size_t watki = 0,
+                                                 const UstawieniaZbieznosci* zbieznosc = nullptr);
+
+/**
+ * Zapisuje wyniki przeglądu w formacie wyniki_testow.csv (z nagłówkiem).
+ */
+void zapisz_wyniki_csv(const std::vector<WynikPrzebiegu>& wyniki, std::ostream& out);
+
+/**
+ * Scala statystyki powtórzeń każdego zestawu parametrów (kolejne wyniki od powtórzenia 0)
+ * i zapisuje je w formacie CSV: jeden wiersz na zestaw, z łączną liczbą kroków,
+ * średnią energią, jej błędem, τ_int i najlepszą energią.
+ */
+void zapisz_statystyki_csv(const std::vector<WynikPrzebiegu>& wyniki, std::ostream& out);
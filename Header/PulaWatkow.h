@@ -0,0 +1,62 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Klasa PulaWatkow: pula wątków z podkradaniem zadań (work stealing).
+ * Każdy wątek ma własną kolejkę: bierze zadania z jej końca (LIFO),
+ * a gdy jest pusta, podkrada z początku kolejek innych wątków (FIFO).
+ * Zadania dodane z wnętrza zadania trafiają do kolejki bieżącego wątku.
+ */
+class PulaWatkow {
+public:
+    /**
+     * @param liczba_watkow 0 - liczba rdzeni (std::thread::hardware_concurrency)
+     */
+    explicit PulaWatkow(size_t liczba_watkow = 0);
+    ~PulaWatkow();
+
+    PulaWatkow(const PulaWatkow&) = delete;
+    PulaWatkow& operator=(const PulaWatkow&) = delete;
+
+    /**
+     * Dodaje zadanie do wykonania.
+     */
+    void dodaj(std::function<void()> zadanie);
+
+    /**
+     * Czeka na zakończenie wszystkich dodanych zadań.
+     * Pierwszy wyjątek rzucony przez zadanie jest tu rzucany ponownie.
+     */
+    void czekaj();
+
+    size_t liczba_watkow() const { return watki.size(); }
+
+private:
+    struct Kolejka {
+        std::mutex mutex;
+        std::deque<std::function<void()>> zadania;
+    };
+
+    std::vector<std::unique_ptr<Kolejka>> kolejki;
+    std::vector<std::thread> watki;
+
+    std::mutex mutex_stanu;
+    std::condition_variable sygnal_pracy;
+    std::condition_variable sygnal_gotowe;
+    size_t w_kolejkach;      // zadania czekające w kolejkach
+    size_t niezakonczone;    // zadania czekające lub wykonywane
+    size_t nastepna;         // kolejka dla zadań spoza puli (po kolei)
+    bool koniec;
+    std::exception_ptr blad;
+
+    bool wez(size_t id, std::function<void()>& zadanie);
+    void petla(size_t id);
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Binarny format punktu kontrolnego (.bin, little-endian):
+ *
+ *   "HPCK", uint32 wersja, treść zapisana przez HP_model, uint64 suma kontrolna FNV-1a
+ *   (liczona z wszystkich wcześniejszych bajtów)
+ *
+ * Plik zapisywany jest do `sciezka.tmp` i podmieniany przez rename, więc
+ * przerwany zapis nigdy nie niszczy poprzedniego punktu kontrolnego.
+ */
+namespace punkt_kontrolny {
+    constexpr char MAGIA[4] = {'H', 'P', 'C', 'K'};
+    constexpr uint32_t WERSJA = 7;
+
+    /**
+     * Zapisuje dane do pliku tymczasowego, utrwala go (fsync) i atomowo zastępuje
+     * nim `sciezka`, po czym utrwala katalog, by zmiana nazwy przetrwała awarię.
+     */
+    bool zapisz_atomowo(const std::string& sciezka, const std::vector<uint8_t>& dane);
+}
+
+/**
+ * Klasa ZapisBinarny: serializacja pól punktu kontrolnego do bufora w pamięci.
+ */
+class ZapisBinarny {
+public:
+    ZapisBinarny();
+
+    void u32(uint32_t v);
+    void u64(uint64_t v);
+    void i32(int32_t v) { u32(static_cast<uint32_t>(v)); }
+    void i64(int64_t v) { u64(static_cast<uint64_t>(v)); }
+    void f64(double v);
+    void tekst(const std::string& s);
+
+    /**
+     * Dopisuje sumę kontrolną i zwraca gotową zawartość pliku.
+     */
+    const std::vector<uint8_t>& zakoncz();
+
+private:
+    std::vector<uint8_t> dane;
+};
+
+/**
+ * Klasa OdczytBinarny: odczyt pól w kolejności zapisu.
+ * Po pierwszym błędzie (koniec danych) wszystkie odczyty zwracają zera, a ok() - false.
+ */
+class OdczytBinarny {
+public:
+    /**
+     * Wczytuje plik i sprawdza nagłówek oraz sumę kontrolną.
+     */
+    bool otworz(const std::string& sciezka);
+
+    uint32_t u32();
+    uint64_t u64();
+    int32_t i32() { return static_cast<int32_t>(u32()); }
+    int64_t i64() { return static_cast<int64_t>(u64()); }
+    double f64();
+    std::string tekst();
+
+    bool ok() const { return poprawny; }
+
+    /**
+     * Czy odczytano całą treść (do sumy kontrolnej) - nadmiarowe bajty oznaczają inny układ sekcji.
+     */
+    bool na_koncu() const { return poprawny && pozycja == koniec; }
+
+private:
+    std::vector<uint8_t> dane;
+    size_t pozycja = 0;
+    size_t koniec = 0;
+    bool poprawny = false;
+
+    const uint8_t* wez(size_t n);
+};
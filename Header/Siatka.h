@@ -0,0 +1,104 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Vec3.h"
+
+/**
+ * Klasa SiatkaZajetosci: gęsta siatka zajętości węzłów sieci 3D.
+ * Płaska tablica komórek z periodycznym zawijaniem współrzędnych (maska bitowa),
+ * rozmiar w każdej osi to potęga dwójki większa od rozpiętości łańcucha.
+ * Każda komórka przechowuje indeks aminokwasu i jego typ (H/P) albo PUSTA.
+ * Aktualizacje są punktowe (wstaw/usun), bez haszowania i alokacji.
+ */
+class SiatkaZajetosci {
+public:
+    static constexpr int32_t PUSTA = -1;
+
+    SiatkaZajetosci();
+
+    /**
+     * Usuwa wszystkie aminokwasy i wraca do minimalnego rozmiaru siatki.
+     */
+    void wyczysc();
+
+    /**
+     * Rezerwuje pamięć na największą siatkę, jakiej może potrzebować łańcuch o danej
+     * długości (suma rozpiętości w trzech osiach nie przekracza dlugosc - 1), więc
+     * powiększanie siatki nie alokuje pamięci. Dla długich łańcuchów, gdy rezerwa
+     * przekroczyłaby MAKS_BITY_REZERWY, nic nie robi - siatka rośnie jak dotąd.
+     */
+    void zarezerwuj(size_t dlugosc);
+
+    /**
+     * Zwraca zawartość komórki dla węzła p (PUSTA albo zakodowany aminokwas).
+     * Zapytania muszą dotyczyć węzłów w odległości co najwyżej MARGINES od łańcucha.
+     */
+    int32_t komorka(const Vec3& p) const { return komorki[indeks_komorki(p)]; }
+    bool wolne(const Vec3& p) const { return komorka(p) == PUSTA; }
+
+    /**
+     * Dekodowanie zawartości niepustej komórki.
+     */
+    static int indeks_aminokwasu(int32_t k) { return k >> 1; }
+    static bool hydrofobowy(int32_t k) { return (k & 1) != 0; }
+
+    /**
+     * Wstawia aminokwas o danym indeksie i typie do węzła p.
+     * W razie potrzeby powiększa siatkę (rzadko, koszt zamortyzowany).
+     */
+    void wstaw(const Vec3& p, size_t indeks, char typ);
+
+    /**
+     * Wstawia aminokwas do węzła p wewnątrz pudła ustalonego przez dopasuj(min, max),
+     * bez powiększania siatki i zmiany pudła: zapisuje tylko komórkę p, więc
+     * wątki mogą jednocześnie zajmować i zwalniać różne węzły.
+     */
+    void zajmij(const Vec3& p, size_t indeks, char typ) {
+        komorki[indeks_komorki(p)] = (static_cast<int32_t>(indeks) << 1) | (typ == 'H' ? 1 : 0);
+    }
+
+    /**
+     * Zwalnia węzeł p.
+     */
+    void usun(const Vec3& p) { komorki[indeks_komorki(p)] = PUSTA; }
+
+    /**
+     * Okresowe dopasowanie: wyznacza dokładne pudło ograniczające łańcuch
+     * (łańcuch dryfuje, a pudło w wstaw tylko rośnie). Koszt O(N), bez realokacji,
+     * o ile łańcuch mieści się w obecnym rozmiarze.
+     */
+    void dopasuj(const std::vector<Vec3>& pozycje);
+
+    /**
+     * Dopasowanie do pudła [min, max] podanego przez wywołującego (np. pudła łańcucha
+     * z zapasem na ruchy, które wykona się potem przez zajmij). Pudło musi zawierać
+     * wszystkie zajęte węzły.
+     */
+    void dopasuj(const Vec3& min, const Vec3& max);
+
+private:
+    // Zapas między rozpiętością łańcucha a rozmiarem siatki w każdej osi
+    static constexpr int MARGINES = 8;
+    // Największa rezerwa: 2^22 komórek (16 MB na bufor)
+    static constexpr int MAKS_BITY_REZERWY = 22;
+
+    std::vector<int32_t> komorki;
+    std::vector<int32_t> zapas;     // poprzednia tablica komórek przy powiększaniu
+    bool zarezerwowana = false;
+    int bity[3];
+    int maska[3];
+
+    // Konserwatywne pudło ograniczające zajęte węzły
+    Vec3 min_poz, max_poz;
+    bool pusta;
+
+    size_t indeks_komorki(const Vec3& p) const {
+        return static_cast<size_t>(p.x & maska[0])
+             | (static_cast<size_t>(p.y & maska[1]) << bity[0])
+             | (static_cast<size_t>(p.z & maska[2]) << (bity[0] + bity[1]));
+    }
+
+    void ustaw_rozmiar(const int nowe_bity[3]);
+    void powieksz(const Vec3& nowe_min, const Vec3& nowe_max);
+};
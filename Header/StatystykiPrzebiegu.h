@@ -0,0 +1,158 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <vector>
+#include "PunktKontrolny.h"
+#include "Vec3.h"
+
+/**
+ * Klasa StatystykiPrzebiegu: statystyki energii liczone w trakcie symulacji,
+ * w czasie O(1) na krok (zamortyzowanym), bez zapisu i parsowania energia.txt.
+ *
+ * - Średnia i wariancja z dokładnych sum całkowitych (energia jest całkowita).
+ * - Histogram energii (tablica rozszerzana w miarę pojawiania się nowych energii).
+ * - Najlepsza energia z numerem kroku i kopią konformacji (kopiowana tylko przy poprawie).
+ * - Akceptacja każdego typu ruchu: całkowita i w ostatnim pełnym oknie `okno_akceptacji` kroków.
+ * - Czas autokorelacji τ_int metodą blokowania (Flyvbjerg-Petersen): na poziomie k
+ *   średnie bloków 2^k kolejnych energii dają błąd średniej σ_k, a
+ *   τ_int = max_k N σ_k² / (2 σ²) po wszystkich poziomach o co najmniej MIN_BLOKOW
+ *   blokach (τ_int = 1/2 dla energii nieskorelowanych). Maksimum zamiast ostatniego
+ *   poziomu przybliża plateau σ_k i nie daje się zaniżyć szumowi najgłębszych poziomów. Oszacowanie jest wiarygodne, gdy przebieg
+ *   ma co najmniej ~1000 τ_int kroków; krótszy przebieg daje wartość zaniżoną.
+ *
+ * Statystyki kilku przebiegów można scalić; histogram, średnia i najlepsza energia
+ * scalają się dokładnie, a τ_int ma sens dla przebiegów o tych samych parametrach.
+ */
+class StatystykiPrzebiegu {
+public:
+    static constexpr int LICZBA_TYPOW_RUCHU = 4;    // koniec, narożnik, crankshaft, pull
+    static constexpr long long MIN_BLOKOW = 32;
+
+    explicit StatystykiPrzebiegu(long long okno_akceptacji = 10000);
+
+    /**
+     * Rejestruje stan po kroku `krok`.
+     * @param typ_ruchu typ proponowanego ruchu (0..LICZBA_TYPOW_RUCHU-1) albo -1
+     */
+    void dodaj(long long krok, int energia, int typ_ruchu, bool zaakceptowano, const std::vector<Vec3>& pozycje) {
+        suma += energia;
+        suma_kw += static_cast<int64_t>(energia) * energia;
+        ++liczba;
+        zlicz_w_histogramie(energia);
+        if (energia < najlepsza_energia) {
+            najlepsza_energia = energia;
+            krok_najlepszej = krok;
+            najlepsza_konformacja = pozycje;
+        }
+        if (typ_ruchu >= 0) {
+            ++okno_proponowane[typ_ruchu];
+            okno_zaakceptowane[typ_ruchu] += zaakceptowano;
+        }
+        if (++kroki_w_oknie == okno_akceptacji) zamknij_okno();
+        dodaj_do_blokow(energia);
+    }
+
+    /**
+     * Dołącza statystyki innego przebiegu.
+     */
+    void scal(const StatystykiPrzebiegu& inne);
+
+    void wyczysc();
+
+    long long get_liczba() const { return liczba; }
+    double get_srednia() const;
+    double get_wariancja() const;
+
+    /**
+     * Liczba kroków zakończonych energią `energia`.
+     */
+    uint64_t get_histogram(int energia) const;
+    int get_energia_min() const { return energia_histogramu; }
+    int get_energia_max() const { return energia_histogramu + static_cast<int>(histogram.size()) - 1; }
+
+    int get_najlepsza_energia() const { return najlepsza_energia; }
+    long long get_krok_najlepszej() const { return krok_najlepszej; }
+    const std::vector<Vec3>& get_najlepsza_konformacja() const { return najlepsza_konformacja; }
+
+    /**
+     * Akceptacja typu ruchu w całym przebiegu i w ostatnim pełnym oknie (0, gdy brak propozycji).
+     */
+    double get_akceptacja(int typ_ruchu) const;
+    double get_akceptacja_okna(int typ_ruchu) const;
+
+    /**
+     * Całkowity czas autokorelacji energii w krokach (0, gdy energia stała lub za mało danych).
+     */
+    double get_czas_autokorelacji() const;
+
+    /**
+     * Błąd statystyczny średniej energii z uwzględnieniem autokorelacji.
+     */
+    double get_blad_sredniej() const;
+
+    /**
+     * Zwięzłe podsumowanie: linie "klucz wartość", na końcu linie "histogram E liczba".
+     */
+    void zapisz_podsumowanie(std::ostream& out) const;
+
+    void zapisz_stan(ZapisBinarny& zapis) const;
+    std::function<void()> odczytaj_stan(OdczytBinarny& odczyt);   // jak HarmonogramTemperatury
+
+private:
+    // Poziom blokowania: sumy średnich bloków 2^k energii i niesparowany blok
+    struct Poziom {
+        double suma = 0.0, suma_kw = 0.0;
+        long long liczba = 0;
+        double oczekujacy = 0.0;
+        bool ma_oczekujacy = false;
+    };
+
+    long long okno_akceptacji;
+
+    int64_t suma, suma_kw;
+    long long liczba;
+
+    std::vector<uint64_t> histogram;
+    int energia_histogramu;         // energia odpowiadająca histogram[0]
+
+    int najlepsza_energia;
+    long long krok_najlepszej;
+    std::vector<Vec3> najlepsza_konformacja;
+
+    long long kroki_w_oknie;
+    long long okno_proponowane[LICZBA_TYPOW_RUCHU], okno_zaakceptowane[LICZBA_TYPOW_RUCHU];
+    long long proponowane[LICZBA_TYPOW_RUCHU], zaakceptowane[LICZBA_TYPOW_RUCHU];
+    double akceptacja_okna[LICZBA_TYPOW_RUCHU];
+
+    std::vector<Poziom> poziomy;
+
+    void zlicz_w_histogramie(int energia) {
+        const long long indeks = static_cast<long long>(energia) - energia_histogramu;
+        if (indeks >= 0 && indeks < static_cast<long long>(histogram.size())) {
+            ++histogram[indeks];
+        } else {
+            rozszerz_histogram(energia, 1);
+        }
+    }
+
+    void dodaj_do_blokow(double wartosc) {
+        for (size_t k = 0; ; ++k) {
+            if (k == poziomy.size()) poziomy.emplace_back();
+            Poziom& p = poziomy[k];
+            p.suma += wartosc;
+            p.suma_kw += wartosc * wartosc;
+            ++p.liczba;
+            if (!p.ma_oczekujacy) {
+                p.oczekujacy = wartosc;
+                p.ma_oczekujacy = true;
+                return;
+            }
+            wartosc = 0.5 * (p.oczekujacy + wartosc);
+            p.ma_oczekujacy = false;
+        }
+    }
+
+    void rozszerz_histogram(int energia, uint64_t liczba_krokow);
+    void zamknij_okno();
+};
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "Vec3.h"
+#include "HP_model.h"
+
+/**
+ * Ustawienia równoległego Monte Carlo z dekompozycją w szachownicę.
+ */
+struct UstawieniaSzachownicy {
+    int bity_komorki = 3;               // bok komórki domeny: 2^bity_komorki węzłów (co najmniej 2)
+    int przemiatania_na_podzial = 4;    // co ile przemiatań nowy podział (O(N), w jednym wątku)
+    size_t watki = 0;                   // 0 - liczba rdzeni
+    uint64_t ziarno = 0;
+};
+
+/**
+ * Klasa SzachownicaMC: Monte Carlo jednego długiego łańcucha (10^4-10^5 aminokwasów)
+ * na wielu wątkach, z dekompozycją przestrzeni w szachownicę.
+ *
+ * - Przestrzeń dzielona jest na sześcienne komórki o boku L = 2^bity_komorki, przesunięte
+ *   o losowy wektor, więc granice komórek nie są stałe. Aminokwasy nie opuszczają komórek,
+ *   więc podział (sekwencyjny) pozostaje ważny przez przemiatania_na_podzial przemiatań.
+ *   Kolor komórki (jeden z 8) to parzystość jej współrzędnych: dwie komórki jednego koloru
+ *   dzieli co najmniej jedna cała komórka.
+ * - Kolory przetwarzane są po kolei, w losowej kolejności; komórki jednego koloru -
+ *   równolegle na puli wątków. Komórka wykonuje tyle propozycji, ile ma aminokwasów,
+ *   więc przemiatanie to N propozycji.
+ * - Ruchy są lokalne (koniec, narożnik, crankshaft, jak w HP_model::TrybPropozycji::Lokalny),
+ *   a ruch, którego stary albo nowy węzeł wychodzi poza komórkę, liczy się jako odrzucony.
+ *   Wątek zapisuje więc siatkę tylko w swojej komórce i czyta ją najwyżej jeden węzeł
+ *   dalej - poza zasięgiem innych komórek tego koloru. Zajętość węzłów jest rozłączna
+ *   z konstrukcji (bez blokad i operacji atomowych na węzłach), a bariera na końcu koloru
+ *   publikuje zmiany kolejnemu kolorowi.
+ * - Łańcuch przemiatany jest w miejscu: na pozycjach i siatce zajętości modelu, bez ich kopii
+ *   (dla 10^5 aminokwasów gęsta siatka zajmuje ~1 GB). ΔE liczone jest energią lokalną
+ *   modelu (HP_model::energia_lokalna) przesuniętych aminokwasów i sumowane po komórkach;
+ *   energia jest całkowita, więc suma nie zależy od kolejności.
+ * - Każda komórka w każdym kolorze ma własny strumień generatora (ziarno zależne od numeru
+ *   przemiatania, koloru i położenia komórki), więc wynik nie zależy od liczby wątków.
+ *
+ * Pull moves nie są używane - przesuwają dowolnie długie fragmenty łańcucha.
+ */
+class SzachownicaMC {
+public:
+    explicit SzachownicaMC(const UstawieniaSzachownicy& ustawienia = UstawieniaSzachownicy());
+
+    /**
+     * Wyżarzanie konformacji modelu: temperatura w przemiataniu s to max(T_inf, T0 * alpha^s)
+     * (T0 = T_inf - stała temperatura). Konformacja modelu zmieniana jest w miejscu,
+     * a na końcu model dostaje energię końcową.
+     * @return false, jeśli model nie ma konformacji
+     */
+    bool uruchom(HP_model& model, double T0, double T_inf, double alpha, long long przemiatania);
+
+    /**
+     * Wypisuje energię, akceptację i przepustowość.
+     */
+    void wypisz_statystyki(std::ostream& out) const;
+
+    int get_energia() const { return energia; }
+    long long get_przemiatania() const { return przemiatania; }
+    long long get_proponowane() const { return proponowane; }
+    long long get_zaakceptowane() const { return zaakceptowane; }
+    double get_czas() const { return czas; }
+    size_t get_liczba_watkow() const { return liczba_watkow; }
+
+private:
+    UstawieniaSzachownicy ustawienia;
+    HP_model* model;                        // model przemiatany przez uruchom (poza nim nullptr)
+    size_t dlugosc;
+    int energia;
+
+    // Bieżący podział na komórki: aminokwasy posortowane po komórkach
+    Vec3 poczatek_podzialu;                 // róg komórki (0, 0, 0)
+    int wymiary[3];                         // liczba komórek w każdej osi
+    std::vector<uint32_t> komorka_aminokwasu;
+    std::vector<uint32_t> licznik;          // liczba aminokwasów w komórce (wyzerowany poza podziałem)
+    std::vector<uint32_t> aminokwasy;       // indeksy aminokwasów, komórka po komórce
+    struct Komorka {
+        uint32_t indeks;                    // indeks liniowy komórki
+        uint32_t pierwszy;                  // początek jej aminokwasów w `aminokwasy`
+        uint32_t liczba;
+    };
+    std::vector<Komorka> komorki_koloru[8];
+
+    long long przemiatania;
+    long long proponowane, zaakceptowane;
+    double czas;
+    size_t liczba_watkow;
+
+    struct WynikBloku {
+        int dE = 0;
+        long long zaakceptowane = 0;
+    };
+
+    void podziel(Xoshiro256& gen);
+    void przemiataj_komorke(const Komorka& komorka, uint64_t ziarno, double T,
+                            TablicaAkceptacji& tablica, WynikBloku& wynik);
+};
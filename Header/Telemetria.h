@@ -0,0 +1,122 @@
+#pragma once
+#include <chrono>
+#include <iostream>
+
+/**
+ * Poziom logów wkompilowanych w program (0 - cisza, 1 - postęp, 2 - szczegóły).
+ * Komunikaty powyżej tego poziomu nie trafiają do kodu wynikowego.
+ */
+#ifndef HP_POZIOM_LOGOW
+#define HP_POZIOM_LOGOW 1
+#endif
+
+/**
+ * Pomiary czasu faz kroku Metropolisa (0 - całkowicie usunięte z kodu).
+ */
+#ifndef HP_TELEMETRIA
+#define HP_TELEMETRIA 1
+#endif
+
+/**
+ * Gadatliwość wybierana w czasie działania (nie większa niż HP_POZIOM_LOGOW).
+ */
+enum class Gadatliwosc { Cisza = 0, Postep = 1, Szczegoly = 2 };
+
+/**
+ * Wypisuje komunikat na std::cout, jeśli jego poziom jest wkompilowany
+ * i nie przekracza bieżącej gadatliwości. Bez std::endl - bez wymuszania zapisu.
+ */
+#define HP_LOG(poziom, gadatliwosc, komunikat)                                        \
+    do {                                                                              \
+        if constexpr (static_cast<int>(poziom) <= HP_POZIOM_LOGOW) {                  \
+            if (static_cast<int>(gadatliwosc) >= static_cast<int>(poziom)) {          \
+                std::cout << komunikat;                                               \
+            }                                                                         \
+        }                                                                             \
+    } while (0)
+
+/**
+ * Klasa Telemetria: próbkowane liczniki czasu faz kroku symulacji
+ * i wydajność całego przebiegu (kroki/s).
+ * Czas faz mierzony jest tylko w co `co_ile`-tym kroku, więc koszt
+ * pomiaru jest pomijalny; przy co_ile = 0 lub HP_TELEMETRIA = 0 - zerowy.
+ */
+class Telemetria {
+public:
+    enum Faza { Propozycja = 0, Energia, Siatka, Wyjscie, LICZBA_FAZ };
+
+    Telemetria();
+
+    /**
+     * Co który krok mierzyć czas faz (0 - pomiary wyłączone).
+     */
+    void ustaw_probkowanie(int co_ile) { this->co_ile = co_ile; }
+
+    /**
+     * Zeruje liczniki i zapamiętuje początek przebiegu.
+     */
+    void rozpocznij();
+
+    /**
+     * Zamyka przebieg liczący `kroki` kroków.
+     */
+    void zakoncz(long kroki);
+
+    /**
+     * Czy w danym kroku mierzyć czas faz.
+     */
+    bool probkuj(long krok) const {
+        if constexpr (HP_TELEMETRIA != 0) {
+            return co_ile > 0 && krok % co_ile == 0;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * Wydajność: kroki/s od rozpoczęcia do zakończenia lub do chwili `krok`.
+     */
+    double kroki_na_sekunde(long krok) const;
+    double kroki_na_sekunde() const { return kroki_na_sekunde(kroki); }
+
+    /**
+     * Wypisuje średni czas faz na krok i wydajność przebiegu.
+     */
+    void raport(std::ostream& out) const;
+
+    /**
+     * Pomiar zakresowy: dolicza czas od konstrukcji do destrukcji do fazy.
+     */
+    class Pomiar {
+    public:
+        Pomiar(Telemetria& telemetria, Faza faza, bool aktywny)
+            : telemetria(telemetria), faza(faza), aktywny(aktywny) {
+            if (aktywny) start = Zegar::now();
+        }
+        ~Pomiar() {
+            if (aktywny) {
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Zegar::now() - start);
+                telemetria.czas_ns[faza] += ns.count();
+                ++telemetria.probki[faza];
+            }
+        }
+        Pomiar(const Pomiar&) = delete;
+        Pomiar& operator=(const Pomiar&) = delete;
+
+    private:
+        Telemetria& telemetria;
+        Faza faza;
+        bool aktywny;
+        std::chrono::steady_clock::time_point start;
+    };
+
+private:
+    using Zegar = std::chrono::steady_clock;
+
+    int co_ile;
+    long kroki;
+    Zegar::time_point poczatek, koniec;
+    bool zakonczony;
+    long long czas_ns[LICZBA_FAZ];
+    long probki[LICZBA_FAZ];
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Vec3.h"
+
+/**
+ * Binarny format trajektorii (.bin, little-endian):
+ *
+ *   nagłówek: "HPTR", uint32 wersja, uint32 N, uint32 krok_zapisu,
+ *             uint32 rozmiar_klatki, N bajtów sekwencji
+ *   klatka:   int64 krok, int32 energia, 3 x int32 pozycja pierwszego aminokwasu,
+ *             N-1 kodów wiązań po 3 bity (indeks w KIERUNKI), dopełnione do bajtu
+ *
+ * Wszystkie klatki mają ten sam rozmiar, więc indeks klatek jest niejawny:
+ * klatka k zaczyna się od bajtu rozmiar_naglowka + k * rozmiar_klatki.
+ * Urwana ostatnia klatka (przerwany przebieg) jest pomijana przy odczycie.
+ */
+namespace trajektoria {
+    constexpr char MAGIA[4] = {'H', 'P', 'T', 'R'};
+    constexpr uint32_t WERSJA = 1;
+
+    /**
+     * Rozmiar klatki w bajtach dla łańcucha o n aminokwasach.
+     */
+    inline size_t rozmiar_klatki(size_t n) {
+        return 8 + 4 + 3 * 4 + (3 * (n > 0 ? n - 1 : 0) + 7) / 8;
+    }
+
+    /**
+     * Rozmiar nagłówka w bajtach dla łańcucha o n aminokwasach.
+     */
+    inline size_t rozmiar_naglowka(size_t n) {
+        return 4 + 4 * 4 + n;
+    }
+
+    /**
+     * Koduje nagłówek pliku trajektorii.
+     */
+    std::vector<uint8_t> koduj_naglowek(const std::string& sekwencja, int krok_zapisu);
+
+    /**
+     * Koduje klatkę do bufora o rozmiarze co najmniej rozmiar_klatki(pozycje.size());
+     * zwraca jej rozmiar. Zapis do pliku należy do wywołującego (np. ZapisAsynchroniczny).
+     */
+    size_t koduj_klatke(long long krok, int energia, const std::vector<Vec3>& pozycje, uint8_t* bufor);
+}
+
+/**
+ * Klatka trajektorii: numer kroku, energia i pełne pozycje.
+ */
+struct KlatkaTrajektorii {
+    long long krok;
+    int energia;
+    std::vector<Vec3> pozycje;
+};
+
+/**
+ * Klasa OdczytTrajektorii: swobodny dostęp do klatek pliku binarnego.
+ */
+class OdczytTrajektorii {
+public:
+    /**
+     * Otwiera plik i wczytuje nagłówek.
+     * @return false, jeśli plik nie istnieje lub nie jest trajektorią HPTR
+     */
+    bool otworz(const std::string& sciezka);
+
+    const std::string& get_sekwencja() const { return sekwencja; }
+    int get_krok_zapisu() const { return krok_zapisu; }
+    size_t liczba_klatek() const { return klatki; }
+
+    /**
+     * Wczytuje klatkę o numerze k (0 <= k < liczba_klatek()).
+     */
+    bool czytaj_klatke(size_t k, KlatkaTrajektorii& klatka);
+
+private:
+    std::ifstream plik;
+    std::string sekwencja;
+    std::vector<uint8_t> bufor;
+    int krok_zapisu = 1;
+    size_t klatki = 0;
+};
@@ -20,12 +20,7 @@ struct Vec3 {
     }
 };
 
-namespace std {
-    template <>
-    struct hash<Vec3> {
-        std::size_t operator()(const Vec3& v) const {
-            return ((std::hash<int>()(v.x) ^ (std::hash<int>()(v.y) << 1)) >> 1)
-                ^ (std::hash<int>()(v.z) << 1);
-        }
-    };
-}
+// Sześć kierunków do najbliższych sąsiadów na siatce sześciennej
+inline constexpr Vec3 KIERUNKI[6] = {
+    Vec3{1,0,0}, Vec3{-1,0,0}, Vec3{0,1,0}, Vec3{0,-1,0}, Vec3{0,0,1}, Vec3{0,0,-1}
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "HP_model.h"
+
+/**
+ * Ustawienia próbkowania Wanga-Landaua.
+ */
+struct UstawieniaWL {
+    double ln_f_poczatkowe = 1.0;      // początkowy logarytm czynnika modyfikacji
+    double ln_f_koncowe = 1e-6;        // zakończenie po spadku ln f poniżej tej wartości
+    int energia_minimalna = 0;         // dolna granica okna energii (0 - bez granicy)
+    double plaskosc = 0.8;             // histogram płaski: min H >= plaskosc * średnia H
+    long long interwal_sprawdzania = 10000; // co ile kroków sprawdzać płaskość
+    long long maks_krokow = 100000000;
+    bool schemat_1_t = true;           // przejście na ln f = 1/t (Belardinelli-Pereyra)
+    bool losowa_init = true;
+    uint64_t ziarno = 0;               // akceptacja: strumień 1 tego ziarna (model - strumień 0)
+};
+
+/**
+ * Klasa WangLandau: szacuje gęstość stanów g(E) modelu HP.
+ * Używa ruchów HP_model (tryb lokalny, mieszanka ruchów modelu) i jego
+ * przyrostowej energii; zmienia tylko kryterium akceptacji na
+ * min(1, g(E_stara) / g(E_nowa)) (z poprawką Hastingsa dla pull moves).
+ * Energie HP są całkowite, więc histogram ma jeden kosz na każdą
+ * energię 0, -1, ..., -E_maks.
+ * Po każdym kroku ln g(E) += ln f i H(E) += 1; gdy H jest płaski na
+ * odwiedzonych energiach, H jest zerowany, a ln f połowiony. Przy
+ * schemat_1_t, gdy ln f spadnie poniżej 1/t (t - kroki na kosz), dalej ln f = 1/t.
+ * Nowo odwiedzona energia dostaje najmniejsze dotąd ln g i zeruje H.
+ * Dla długich łańcuchów okno można zawęzić do [energia_minimalna, 0] -
+ * ruchy poniżej okna są odrzucane.
+ */
+class WangLandau {
+public:
+    explicit WangLandau(const UstawieniaWL& ustawienia);
+
+    /**
+     * Uruchamia próbkowanie na modelu (tryb propozycji zostaje ustawiony na Lokalny).
+     * @return false jeśli nie udało się wygenerować konformacji startowej
+     */
+    bool uruchom(HP_model& model);
+
+    /**
+     * Zapisuje g(E) do pliku: kolumny E, ln g(E), H(E) dla odwiedzonych energii.
+     * ln g przesunięte tak, by ln g(E_min) = 0 (ważne są tylko różnice).
+     */
+    bool zapisz_gestosc(const std::string& sciezka) const;
+
+    /**
+     * Średnia energia i ciepło właściwe w temperaturze T wyznaczone z g(E).
+     */
+    void termodynamika(double T, double& srednia_energia, double& cieplo_wlasciwe) const;
+
+    /**
+     * Wypisuje przebieg: kroki, końcowe ln f, zakres energii, liczbę iteracji.
+     */
+    void wypisz_statystyki(std::ostream& out) const;
+
+    int get_energia_minimalna() const { return -static_cast<int>(najnizszy_kosz); }
+    double get_ln_f() const { return ln_f; }
+    long long get_kroki() const { return kroki; }
+
+private:
+    UstawieniaWL ustawienia;
+    Xoshiro256 gen;
+
+    std::vector<double> ln_g;       // kosz b = -E
+    std::vector<long long> histogram;
+    std::vector<char> odwiedzone;
+    size_t najnizszy_kosz;          // kosz najniższej znalezionej energii
+    double ln_f;
+    long long kroki;
+    int iteracje;                   // liczba zmniejszeń ln f
+
+    bool plaski() const;
+    void nowy_kosz(size_t b);
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+/**
+ * Ustawienia wsadowego zwijania wielu sekwencji.
+ */
+struct UstawieniaWsadowe {
+    double T0 = 2.0;            // temperatura początkowa wyżarzania
+    double T_inf = 0.2;         // temperatura końcowa
+    double alpha = 0.99995;     // współczynnik chłodzenia (co krok)
+    int kroki = 200000;         // kroki na sekwencję
+    size_t watki = 0;           // 0 - liczba rdzeni
+    size_t okno = 0;            // maks. sekwencji w toku (0 - 4 na wątek)
+    uint64_t ziarno = 1;        // sekwencja nr i używa ziarno_przebiegu(ziarno, i)
+};
+
+/**
+ * Podsumowanie przetwarzania wsadowego.
+ */
+struct StatystykiWsadowe {
+    size_t sekwencje;           // wczytane sekwencje
+    size_t bledne;              // wiersze z niepoprawną sekwencją lub bez konformacji
+    double czas;                // czas całkowity w sekundach
+};
+
+/**
+ * Zwija wszystkie sekwencje czytane strumieniowo z `wejscie` przez API hp_core
+ * (hp_zwin_wsadowo, okno po oknie) i zapisuje po jednym wierszu CSV na sekwencję,
+ * w kolejności wejścia:
+ *
+ *   Indeks,Nazwa,Dlugosc,Status,Energia,Czas_s,Konformacja
+ *
+ * Wiersz wejścia to "sekwencja" albo "nazwa sekwencja"; puste wiersze i
+ * zaczynające się od '#' są pomijane. Każda sekwencja jest wyżarzana
+ * (ruchy lokalne, wszystkie typy ruchów); zapisywana jest najniższa energia
+ * przebiegu i jej konformacja. Konformacja to kierunki kolejnych wiązań: R/L = ±x, U/D = ±y, F/B = ±z.
+ * W toku jest najwyżej `okno` sekwencji, więc pamięć nie zależy od rozmiaru wejścia.
+ */
+StatystykiWsadowe przetworz_wsadowo(std::istream& wejscie, std::ostream& wyjscie,
+                                    const UstawieniaWsadowe& ustawienia);
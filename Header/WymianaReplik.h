@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Vec3.h"
+#include "HP_model.h"
+
+/**
+ * Ustawienia wymiany replik (parallel tempering).
+ */
+struct UstawieniaWymiany {
+    std::string sekwencja;            // puste - sekwencja domyślna HP_model (ubikwityna)
+    int liczba_replik = 0;            // 0 - liczba rdzeni (co najmniej 2)
+    double T_min = 0.5;               // najniższa temperatura drabiny
+    double T_max = 5.0;               // najwyższa temperatura drabiny
+    int kroki_miedzy_wymianami = 100; // kroki MC każdej repliki między próbami wymiany
+    long long maks_krokow = 1000000;  // limit kroków na replikę
+    int energia_docelowa = 0;         // zatrzymanie po osiągnięciu (0 - bez celu)
+    bool adaptacja_drabiny = true;    // dopasowanie odstępów temperatur do częstości wymian
+    double docelowa_akceptacja = 0.3; // pożądana częstość udanych wymian sąsiadów
+    int interwal_adaptacji = 50;      // co ile rund wymian poprawiać drabinę
+    bool losowa_init = true;
+    HP_model::TrybPropozycji tryb = HP_model::TrybPropozycji::Lokalny;
+    uint64_t ziarno = 0;
+};
+
+// Statystyki pojedynczej repliki
+struct StatystykiRepliki {
+    long long kroki = 0;
+    long long zaakceptowane = 0;
+    int energia = 0;             // energia końcowa
+    int najlepsza_energia = 0;
+    long long wymiany = 0;       // udane zmiany temperatury
+    double czas_do_celu = -1.0;  // sekundy do osiągnięcia energii docelowej (-1 - nie osiągnięto)
+};
+
+// Statystyki wymian pary sąsiednich temperatur (i, i+1)
+struct StatystykiPary {
+    long long proby = 0;
+    long long udane = 0;
+};
+
+/**
+ * Klasa WymianaReplik: K replik HP_model na drabinie temperatur, każda
+ * we własnym wątku. Repliki wykonują po kroki_miedzy_wymianami kroków,
+ * spotykają się na barierze i ostatni przybyły wątek próbuje wymian
+ * sąsiednich temperatur (na przemian pary parzyste i nieparzyste).
+ * Wymieniane są tylko temperatury, nie konformacje, więc runda wymian
+ * kosztuje O(K). Po osiągnięciu energii docelowej przez dowolną replikę
+ * wszystkie kończą po bieżącej rundzie, więc przy stałym ziarnie liczby kroków
+ * i statystyki (poza czasami) się powtarzają.
+ */
+class WymianaReplik {
+public:
+    explicit WymianaReplik(const UstawieniaWymiany& ustawienia);
+
+    /**
+     * Uruchamia symulację.
+     * @return false jeśli nie udało się wygenerować konformacji startowych
+     */
+    bool uruchom();
+
+    /**
+     * Wypisuje drabinę temperatur, częstości wymian i statystyki replik.
+     */
+    void wypisz_statystyki(std::ostream& out) const;
+
+    int get_najlepsza_energia() const { return najlepsza_energia; }
+    const std::vector<Vec3>& get_najlepsza_konformacja() const { return najlepsza_konformacja; }
+    bool osiagnieto_cel() const { return czas_do_celu >= 0.0; }
+    double get_czas_do_celu() const { return czas_do_celu; }
+    double get_czas() const { return czas; }
+    const std::vector<double>& get_temperatury() const { return temperatury; }
+    const std::vector<StatystykiRepliki>& get_statystyki_replik() const { return statystyki; }
+    const std::vector<StatystykiPary>& get_statystyki_par() const { return pary; }
+
+private:
+    UstawieniaWymiany ustawienia;
+    std::vector<double> temperatury;       // drabina, rosnąco
+    std::vector<StatystykiRepliki> statystyki;
+    std::vector<StatystykiPary> pary;
+
+    int najlepsza_energia;
+    std::vector<Vec3> najlepsza_konformacja;
+    double czas_do_celu;
+    double czas;
+
+    void dopasuj_drabine(const std::vector<StatystykiPary>& okno);
+};
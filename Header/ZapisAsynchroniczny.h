@@ -0,0 +1,113 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "KolejkaSPSC.h"
+
+/**
+ * Klasa ZapisAsynchroniczny: zapis strumieni wyjściowych symulacji w wątku tła.
+ * Wątek symulacji kopiuje rekordy do wstępnie przydzielonych buforów i przekazuje
+ * pełne bufory przez bezblokadową kolejkę SPSC; wątek zapisu zwraca puste bufory
+ * drugą kolejką. Pamięć jest ograniczona do liczba_buforow * rozmiar_bufora.
+ * Rekord nigdy nie jest dzielony między bufory, więc odrzucane są całe rekordy.
+ */
+class ZapisAsynchroniczny {
+public:
+    /**
+     * Zachowanie, gdy dysk nie nadąża i brak wolnego bufora:
+     * Blokuj - czekaj na wolny bufor (nic nie ginie),
+     * Odrzuc - pomiń rekord,
+     * Decymuj - pomiń rekord i zapisuj tylko co k-ty rekord strumienia,
+     *           k podwaja się przy każdym braku bufora i maleje, gdy zapis nadąża.
+     */
+    enum class Polityka { Blokuj, Odrzuc, Decymuj };
+
+    enum Strumien { Energia = 0, Trajektoria, Konformacja, LICZBA_STRUMIENI };
+
+    ZapisAsynchroniczny(size_t liczba_buforow = 16, size_t rozmiar_bufora = 1 << 16);
+    ~ZapisAsynchroniczny();
+
+    ZapisAsynchroniczny(const ZapisAsynchroniczny&) = delete;
+    ZapisAsynchroniczny& operator=(const ZapisAsynchroniczny&) = delete;
+
+    void ustaw_polityke(Polityka polityka) { this->polityka = polityka; }
+
+    /**
+     * Otwiera plik strumienia (przed rozpocznij()).
+     * @param od_bajtu > 0 - kontynuacja: istniejący plik jest przycinany do tej
+     *                 długości i dalsze rekordy są dopisywane (false, jeśli plik jest krótszy)
+     */
+    bool otworz(Strumien strumien, const std::string& sciezka, uint64_t od_bajtu = 0);
+
+    /**
+     * Uruchamia wątek zapisu.
+     */
+    void rozpocznij();
+
+    /**
+     * Dopisuje rekord do strumienia (wątek symulacji). Rekord dłuższy
+     * niż rozmiar bufora jest zapisywany w kilku częściach i zawsze z blokowaniem.
+     * @param wymagany true - zawsze czekaj na bufor, niezależnie od polityki
+     * @return false, jeśli rekord został pominięty zgodnie z polityką
+     */
+    bool zapisz(Strumien strumien, const void* dane, size_t n, bool wymagany = false);
+
+    /**
+     * Wysyła niepełne bufory i czeka, aż wszystkie przyjęte rekordy trafią do plików
+     * (np. przed zapisem punktu kontrolnego). Pliki pozostają otwarte.
+     */
+    void oproznij();
+
+    /**
+     * Wysyła niepełne bufory, czeka na zapis wszystkiego i zamyka pliki.
+     */
+    void zakoncz();
+
+    /**
+     * Długość strumienia w bajtach: początek z otworz() plus wszystkie przyjęte rekordy.
+     */
+    uint64_t get_dlugosc(Strumien strumien) const { return dlugosc[strumien]; }
+
+    /**
+     * Liczba rekordów pominiętych przez politykę Odrzuc/Decymuj.
+     */
+    uint64_t get_pominiete() const { return pominiete; }
+
+private:
+    struct Bufor {
+        int strumien;
+        size_t zajete;
+        std::vector<char> dane;
+    };
+
+    std::vector<Bufor> bufory;
+    KolejkaSPSC<uint32_t> pelne;
+    KolejkaSPSC<uint32_t> puste;
+    std::ofstream pliki[LICZBA_STRUMIENI];
+
+    // Stan producenta
+    int64_t biezacy[LICZBA_STRUMIENI];
+    uint64_t licznik_rekordow[LICZBA_STRUMIENI];
+    uint64_t dlugosc[LICZBA_STRUMIENI];
+    uint32_t decymacja;
+    uint64_t pominiete;
+    Polityka polityka;
+
+    // Wątek zapisu
+    std::thread watek;
+    std::mutex mutex;
+    std::condition_variable sygnal;
+    std::atomic<bool> koniec;
+    bool dziala;
+
+    bool wez_bufor(int strumien, bool czekaj);
+    void wyslij(int strumien);
+    void zapisz_bufor(uint32_t idx);
+    void petla_zapisu();
+};
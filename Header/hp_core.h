@@ -0,0 +1,100 @@
+#pragma once
+
+/**
+ * API biblioteki hp_core w języku C: zwijanie sekwencji HP wyżarzaniem Metropolisa
+ * bez plików pośrednich i bez osobnych procesów.
+ *
+ * Wywołujący opisuje zadania (sekwencja, parametry, ziarno, własny bufor na konformację),
+ * a biblioteka wpisuje wyniki do tych samych struktur. Układ struktur zmienia się
+ * tylko razem z HP_API_WERSJA (zob. hp_wersja_api).
+ *
+ * Wyniki zależą wyłącznie od sekwencji, parametrów i ziarna - nie od liczby wątków
+ * ani kolejności zadań we wsadzie. Funkcje są bezpieczne wątkowo.
+ *
+ * Biblioteka budowana jest z -fvisibility=hidden: eksportowane są tylko funkcje
+ * oznaczone HP_API, a klasy C++ modelu pozostają szczegółem implementacji.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(HP_CORE_WSPOLDZIELONA)
+#  ifdef HP_CORE_BUDOWA
+#    define HP_API __declspec(dllexport)
+#  else
+#    define HP_API __declspec(dllimport)
+#  endif
+#elif defined(__GNUC__)
+#  define HP_API __attribute__((visibility("default")))
+#else
+#  define HP_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HP_API_WERSJA 2
+
+/** Status zadania */
+enum {
+    HP_OK = 0,
+    HP_BLAD_ARGUMENTU = 1,      /* NULL albo parametry poza zakresem */
+    HP_BLAD_SEKWENCJI = 2,      /* pusta sekwencja albo znak inny niż H/P */
+    HP_BLAD_BUFORA = 3,         /* bufor konformacji za mały; energia jest wpisana */
+    HP_BLAD_STARTU = 4,         /* nie udało się wygenerować konformacji startowej */
+    HP_BLAD_WEWNETRZNY = 5      /* błąd wewnętrzny, np. brak pamięci */
+};
+
+/** Parametry wyżarzania */
+typedef struct hp_parametry {
+    double T0;                  /* temperatura początkowa */
+    double T_inf;               /* temperatura końcowa */
+    double alpha;               /* współczynnik chłodzenia geometrycznego */
+    int64_t kroki;              /* liczba kroków (najwyżej INT32_MAX) */
+    uint64_t ziarno;            /* ziarno generatora */
+    int32_t losowa_init;        /* 1 - losowa konformacja startowa, 0 - linia prosta */
+    int32_t wczesne_zakonczenie;/* 1 - koniec po zbieżności (domyślny detektor zbieżności) */
+    int32_t lokalne_ruchy;      /* 1 - propozycje lokalne O(1), 0 - wyliczanie wszystkich ruchów O(N) */
+} hp_parametry;
+
+/** Zadanie: pola wejściowe wypełnia wywołujący, wyjściowe - biblioteka */
+typedef struct hp_zadanie {
+    /* wejście */
+    const char* sekwencja;      /* litery H/P zakończone zerem */
+    hp_parametry parametry;
+    int32_t* konformacja;       /* bufor na 3 * pojemnosc liczb (x, y, z kolejnych aminokwasów) albo NULL */
+    size_t pojemnosc;           /* liczba aminokwasów mieszczących się w buforze */
+
+    /* wyjście */
+    int32_t status;             /* HP_OK albo kod błędu */
+    int32_t energia;            /* najniższa energia przebiegu (konformacja - jej stan) */
+    int64_t wykonane_kroki;     /* mniej niż kroki po wczesnym zakończeniu */
+    size_t dlugosc;             /* długość sekwencji (tyle aminokwasów wymaga bufor) */
+    double czas;                /* czas zadania w sekundach */
+} hp_zadanie;
+
+/** Wersja API, z którą zbudowano bibliotekę (porównaj z HP_API_WERSJA). */
+HP_API int hp_wersja_api(void);
+
+/**
+ * Parametry domyślne: T0 = 10, T_inf = 0.5, alpha = 0.999, 10000 kroków, ziarno 1,
+ * start losowy, wszystkie ruchy.
+ */
+HP_API void hp_parametry_domyslne(hp_parametry* parametry);
+
+/** Zwija jedno zadanie. Zwraca status (też wpisany do zadanie->status). */
+HP_API int hp_zwin(hp_zadanie* zadanie);
+
+/**
+ * Zwija `liczba` zadań na puli `watki` wątków (0 - liczba rdzeni).
+ * Zwraca liczbę zadań zakończonych statusem HP_OK.
+ */
+HP_API size_t hp_zwin_wsadowo(hp_zadanie* zadania, size_t liczba, size_t watki);
+
+/** Opis statusu (statyczny napis). */
+HP_API const char* hp_opis_statusu(int status);
+
+#ifdef __cplusplus
+}
+#endif
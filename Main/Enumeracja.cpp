@@ -0,0 +1,346 @@
+#include "Enumeracja.h"
+#include "PERM.h"
+#include "PulaWatkow.h"
+#include "Siatka.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+
+namespace {
+    // Liczba dozwolonych kierunków (początek KIERUNKI) na danym etapie łamania symetrii:
+    // 0 - użyta tylko oś x, 1 - osie x i y, 2 - wszystkie osie
+    constexpr int LICZBA_KIERUNKOW[3] = {3, 5, 6};
+
+    // Minimalna liczba zadań na wątek przy podziale drzewa
+    constexpr size_t ZADANIA_NA_WATEK = 32;
+
+    // Co ile węzłów lokalny licznik jest dodawany do wspólnego
+    constexpr long long PACZKA_WEZLOW = 1 << 14;
+
+    int etap_po_ruchu(int etap, int kierunek) {
+        if (etap == 0 && kierunek == 2) return 1;
+        if (etap == 1 && kierunek == 4) return 2;
+        return etap;
+    }
+
+    /**
+     * Dane wspólne dla wszystkich wątków: sekwencja, tablice oszacowań i najlepszy wynik.
+     */
+    struct Wspolne {
+        std::string sekwencja;
+        int N;
+        std::vector<int> statyczne;     // statyczne[n]: maks. kontakty aminokwasów n..N-1
+        std::vector<int> miedzy_nowymi; // miedzy_nowymi[n]: maks. kontakty tylko wewnątrz n..N-1
+        std::vector<int> h_dalej[2];    // h_dalej[p][n]: liczba H o parzystości p wśród n..N-1
+        std::vector<int> miejsca_dalej[2]; // miejsca_dalej[p][n]: niezwiązani sąsiedzi tych H
+        std::atomic<int> najlepsze;     // najwięcej kontaktów H-H w pełnym łańcuchu
+        std::atomic<long long> wezly;
+        std::atomic<bool> stop;
+        long long maks_wezlow;
+    };
+
+    // Prefiks łańcucha - jedno zadanie
+    struct Prefiks {
+        std::vector<Vec3> lancuch;
+        int kontakty;
+        int etap;
+    };
+
+    /**
+     * Przeszukiwanie w głąb jednego poddrzewa (własna siatka i łańcuch).
+     */
+    class Przeszukiwanie {
+    public:
+        int najlepsze = -1;             // najlepszy wynik w tym poddrzewie
+        uint64_t liczba = 0;            // liczba konformacji z tym wynikiem
+        std::vector<Vec3> przyklad;
+        std::vector<Prefiks>* prefiksy = nullptr;  // tryb podziału: zbieranie prefiksów
+        int glebokosc_podzialu = 0;
+
+        explicit Przeszukiwanie(Wspolne& w) : w(w) { lancuch.reserve(w.N); }
+
+        void poloz(const Vec3& p) {
+            aktualizuj_wolne(p, lancuch.size(), 1);
+            siatka.wstaw(p, lancuch.size(), w.sekwencja[lancuch.size()]);
+            lancuch.push_back(p);
+        }
+
+        void zdejmij() {
+            const Vec3 p = lancuch.back();
+            siatka.usun(p);
+            lancuch.pop_back();
+            aktualizuj_wolne(p, lancuch.size(), -1);
+        }
+
+        void szukaj(int kontakty, int etap) {
+            const int n = static_cast<int>(lancuch.size());
+            if (n == w.N) {
+                zapisz_wynik(kontakty);
+                return;
+            }
+            if (w.stop.load(std::memory_order_relaxed) || odetnij(kontakty)) return;
+            if (prefiksy && n == glebokosc_podzialu) {
+                prefiksy->push_back({lancuch, kontakty, etap});
+                return;
+            }
+
+            // Kandydaci w kolejności malejących kontaktów - dobre wyniki wcześnie wzmacniają odcinanie
+            struct Kandydat { Vec3 p; int kontakty; int kierunek; };
+            Kandydat kandydaci[6];
+            int liczba_kandydatow = 0;
+            const bool h = w.sekwencja[n] == 'H';
+            for (int k = 0; k < LICZBA_KIERUNKOW[etap]; ++k) {
+                const Vec3 p = lancuch.back() + KIERUNKI[k];
+                if (!siatka.wolne(p)) continue;
+                int nowe = 0;
+                if (h) {
+                    for (const auto& d : KIERUNKI) {
+                        const int32_t c = siatka.komorka(p + d);
+                        if (c != SiatkaZajetosci::PUSTA && SiatkaZajetosci::hydrofobowy(c) &&
+                            SiatkaZajetosci::indeks_aminokwasu(c) != n - 1) {
+                            ++nowe;
+                        }
+                    }
+                }
+                kandydaci[liczba_kandydatow++] = {p, nowe, k};
+            }
+            std::stable_sort(kandydaci, kandydaci + liczba_kandydatow,
+                             [](const Kandydat& a, const Kandydat& b) { return a.kontakty > b.kontakty; });
+
+            for (int k = 0; k < liczba_kandydatow; ++k) {
+                policz_wezel();
+                poloz(kandydaci[k].p);
+                szukaj(kontakty + kandydaci[k].kontakty, etap_po_ruchu(etap, kandydaci[k].kierunek));
+                zdejmij();
+            }
+        }
+
+        void zakoncz() {
+            w.wezly.fetch_add(niezgloszone, std::memory_order_relaxed);
+            niezgloszone = 0;
+        }
+
+    private:
+        Wspolne& w;
+        SiatkaZajetosci siatka;
+        std::vector<Vec3> lancuch;
+        long long niezgloszone = 0;
+        int wolne_h[2] = {0, 0};    // suma wolnych sąsiadów ułożonych H wg parzystości indeksu
+
+        /**
+         * Zmiana wolne_h przy wstawieniu (znak 1) lub usunięciu (-1) aminokwasu i w wolnym węźle p:
+         * ułożone sąsiednie H tracą (odzyskują) wolne miejsce, a nowy H wnosi własne.
+         */
+        void aktualizuj_wolne(const Vec3& p, size_t i, int znak) {
+            const bool h = w.sekwencja[i] == 'H';
+            for (const auto& d : KIERUNKI) {
+                const int32_t c = siatka.komorka(p + d);
+                if (c == SiatkaZajetosci::PUSTA) {
+                    if (h) wolne_h[i & 1] += znak;
+                } else if (SiatkaZajetosci::hydrofobowy(c)) {
+                    wolne_h[SiatkaZajetosci::indeks_aminokwasu(c) & 1] -= znak;
+                }
+            }
+        }
+
+        void policz_wezel() {
+            if (++niezgloszone < PACZKA_WEZLOW) return;
+            const long long razem = w.wezly.fetch_add(niezgloszone, std::memory_order_relaxed) + niezgloszone;
+            niezgloszone = 0;
+            if (w.maks_wezlow > 0 && razem >= w.maks_wezlow) w.stop.store(true, std::memory_order_relaxed);
+        }
+
+        void zapisz_wynik(int kontakty) {
+            if (kontakty > najlepsze) {
+                najlepsze = kontakty;
+                liczba = 1;
+                przyklad = lancuch;
+            } else if (kontakty == najlepsze) {
+                ++liczba;
+            }
+            int wspolne = w.najlepsze.load(std::memory_order_relaxed);
+            while (kontakty > wspolne &&
+                   !w.najlepsze.compare_exchange_weak(wspolne, kontakty, std::memory_order_relaxed)) {
+            }
+        }
+
+        /**
+         * Czy gałąź nie może dorównać najlepszemu wynikowi (ściśle mniej kontaktów)?
+         * Równe wyniki nie są odcinane, żeby policzyć degenerację.
+         */
+        bool odetnij(int kontakty) {
+            const int n = static_cast<int>(lancuch.size());
+            const int brakuje = w.najlepsze.load(std::memory_order_relaxed) - kontakty;
+            if (brakuje <= 0) return false;
+            if (w.statyczne[n] < brakuje) return true;
+            if (prefiksy) return false;
+
+            // Dynamicznie: nowy kontakt łączy H parzyste z nieparzystym, z których co najmniej
+            // jedno nie jest jeszcze ułożone; ułożone H mają tylko tyle miejsc, ilu wolnych sąsiadów
+            int wolne_miejsca[2];
+            for (int p = 0; p < 2; ++p) wolne_miejsca[p] = w.h_dalej[1 - p][n] > 0 ? wolne_h[p] : 0;
+            const int ostatni = (n - 1) & 1;
+            if (w.sekwencja[n - 1] == 'H' && w.h_dalej[1 - ostatni][n] > 0) {
+                --wolne_miejsca[ostatni];  // jeden wolny sąsiad zajmie następny aminokwas
+            }
+            const int przez_parzystosc = std::min(wolne_miejsca[0] + w.miejsca_dalej[0][n],
+                                                  wolne_miejsca[1] + w.miejsca_dalej[1][n]);
+            const int przez_pary = std::min(wolne_miejsca[0], w.miejsca_dalej[1][n]) +
+                                   std::min(wolne_miejsca[1], w.miejsca_dalej[0][n]) + w.miedzy_nowymi[n];
+            return std::min(przez_parzystosc, przez_pary) < brakuje;
+        }
+    };
+
+    /**
+     * Górne oszacowanie liczby krawędzi siatki między k węzłami: 3k - 3k^(2/3)
+     * (nierówność izoperymetryczna dla Z^3, równość dla sześcianów).
+     */
+    int maks_krawedzie(int k) {
+        return static_cast<int>(std::floor(3.0 * k - 3.0 * std::cbrt(static_cast<double>(k) * k) + 1e-9));
+    }
+
+    /**
+     * Górne oszacowanie kontaktów aminokwasu j z H o indeksach z [od, j - 3]
+     * (kontakt tylko przy nieparzystej różnicy indeksów).
+     */
+    int maks_kontakty(const std::string& s, int j, int od) {
+        if (s[j] != 'H') return 0;
+        int mozliwe = 0;
+        for (int i = od; i <= j - 3; ++i) {
+            if (s[i] == 'H' && ((j - i) & 1)) ++mozliwe;
+        }
+        const int limit = j == static_cast<int>(s.size()) - 1 ? 5 : 4;
+        return std::min(mozliwe, limit);
+    }
+}
+
+Enumeracja::Enumeracja(const std::string& sekwencja, const UstawieniaEnumeracji& ustawienia)
+    : sekwencja(sekwencja), ustawienia(ustawienia), energia_minimalna(0), degeneracja(0),
+      wezly(0), zadania(0), czas(0.0), pelne(false)
+{
+}
+
+bool Enumeracja::uruchom() {
+    const auto start = std::chrono::steady_clock::now();
+    const int N = static_cast<int>(sekwencja.size());
+    energia_minimalna = 0;
+    degeneracja = 0;
+    konformacja.clear();
+    wezly = 0;
+    zadania = 0;
+    pelne = false;
+    if (N == 0) return false;
+
+    Wspolne w;
+    w.sekwencja = sekwencja;
+    w.N = N;
+    w.statyczne.assign(N + 1, 0);
+    w.miedzy_nowymi.assign(N + 1, 0);
+    w.h_dalej[0].assign(N + 1, 0);
+    w.h_dalej[1].assign(N + 1, 0);
+    w.miejsca_dalej[0].assign(N + 1, 0);
+    w.miejsca_dalej[1].assign(N + 1, 0);
+    for (int n = N - 1; n >= 0; --n) {
+        w.statyczne[n] = w.statyczne[n + 1] + maks_kontakty(sekwencja, n, 0);
+        const bool h = sekwencja[n] == 'H';
+        const int miejsca = n == 0 || n == N - 1 ? 5 : 4;
+        for (int p = 0; p < 2; ++p) {
+            w.h_dalej[p][n] = w.h_dalej[p][n + 1] + (h && n % 2 == p);
+            w.miejsca_dalej[p][n] = w.miejsca_dalej[p][n + 1] + (h && n % 2 == p ? miejsca : 0);
+        }
+        for (int j = n; j < N; ++j) w.miedzy_nowymi[n] += maks_kontakty(sekwencja, j, n);
+
+        // Kontakty między H z n..N-1 to krawędzie między nimi bez wiązań H-H łańcucha
+        int liczba_h = 0, wiazania_hh = 0;
+        for (int j = n; j < N; ++j) {
+            if (sekwencja[j] != 'H') continue;
+            ++liczba_h;
+            if (j + 1 < N && sekwencja[j + 1] == 'H') ++wiazania_hh;
+        }
+        w.miedzy_nowymi[n] = std::min(w.miedzy_nowymi[n], maks_krawedzie(liczba_h) - wiazania_hh);
+    }
+    // Znane oszacowanie: szukamy tylko konformacji co najmniej tak dobrych
+    int energia_gorna = std::min(ustawienia.energia_gorna, 0);
+    if (ustawienia.wezly_perm > 0 && N > 2) {
+        UstawieniaPERM ustawienia_perm;
+        ustawienia_perm.maks_wezlow = ustawienia.wezly_perm;
+        ustawienia_perm.energia_docelowa = energia_gorna;
+        PERM perm(sekwencja, ustawienia_perm);
+        if (perm.uruchom()) energia_gorna = std::min(energia_gorna, perm.get_najlepsza_energia());
+    }
+    w.najlepsze = -energia_gorna;
+    w.wezly = 0;
+    w.stop = false;
+    w.maks_wezlow = ustawienia.maks_wezlow;
+
+    PulaWatkow pula(ustawienia.watki);
+    std::mutex mutex;
+    int najlepsze = -1;
+    auto scal = [&](const Przeszukiwanie& p) {
+        std::lock_guard<std::mutex> blokada(mutex);
+        if (p.najlepsze > najlepsze) {
+            najlepsze = p.najlepsze;
+            degeneracja = p.liczba;
+            konformacja = p.przyklad;
+        } else if (p.najlepsze == najlepsze && p.najlepsze >= 0) {
+            degeneracja += p.liczba;
+        }
+    };
+
+    // Podział drzewa: najmniejsza głębokość dająca dość zadań dla wszystkich wątków.
+    // Pełne łańcuchy krótsze od głębokości podziału są liczone już tutaj.
+    Przeszukiwanie podzial(w);
+    std::vector<Prefiks> prefiksy;
+    podzial.prefiksy = &prefiksy;
+    podzial.poloz(Vec3{0, 0, 0});
+    if (N > 1) podzial.poloz(KIERUNKI[0]);
+    for (int glebokosc = std::min(N, 2); ; ++glebokosc) {
+        prefiksy.clear();
+        podzial.najlepsze = -1;
+        podzial.liczba = 0;
+        podzial.glebokosc_podzialu = glebokosc;
+        podzial.szukaj(0, 0);
+        if (prefiksy.size() >= ZADANIA_NA_WATEK * pula.liczba_watkow() || glebokosc >= N) break;
+    }
+    scal(podzial);
+    zadania = prefiksy.size();
+
+    for (const Prefiks& prefiks : prefiksy) {
+        pula.dodaj([&, prefiks_zadania = &prefiks]() {
+            Przeszukiwanie p(w);
+            for (const Vec3& pozycja : prefiks_zadania->lancuch) p.poloz(pozycja);
+            p.szukaj(prefiks_zadania->kontakty, prefiks_zadania->etap);
+            p.zakoncz();
+            scal(p);
+        });
+    }
+    pula.czekaj();
+    podzial.zakoncz();
+
+    // Poddrzewa, których najlepszy wynik jest gorszy od globalnego, nie wnoszą do degeneracji
+    wezly = w.wezly.load();
+    pelne = !w.stop.load() && najlepsze >= 0;
+    energia_minimalna = najlepsze >= 0 ? -najlepsze : 0;
+    if (najlepsze < 0) degeneracja = 0;
+    czas = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return pelne;
+}
+
+bool Enumeracja::zapisz_konformacje(const std::string& sciezka) const {
+    std::ofstream plik(sciezka);
+    if (!plik) return false;
+    for (const auto& poz : konformacja) {
+        plik << poz.x << " " << poz.y << " " << poz.z << "\n";
+    }
+    return static_cast<bool>(plik);
+}
+
+void Enumeracja::wypisz_statystyki(std::ostream& out) const {
+    out << "Enumeracja: węzły drzewa " << wezly << ", zadania " << zadania
+        << (pelne ? "" : " (przerwana - wynik niepełny)") << "\n";
+    out << "Energia minimalna: " << energia_minimalna << ", degeneracja: " << degeneracja
+        << ", czas: " << czas << " s\n";
+}
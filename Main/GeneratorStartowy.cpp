@@ -0,0 +1,101 @@
+#include "GeneratorStartowy.h"
+#include "PulaWatkow.h"
+#include "Przeglad.h"
+#include <algorithm>
+
+GeneratorStartowy::GeneratorStartowy(const UstawieniaGeneratora& ustawienia)
+    : ustawienia(ustawienia), cofniecia(0), restarty(0)
+{
+}
+
+int GeneratorStartowy::wolni_sasiedzi(const SiatkaZajetosci& siatka, const Vec3& p) const {
+    int wolni = 0;
+    for (const auto& kierunek : KIERUNKI) {
+        wolni += siatka.wolne(p + kierunek);
+    }
+    return wolni;
+}
+
+bool GeneratorStartowy::generuj(const std::string& sekwencja, SiatkaZajetosci& siatka, Xoshiro256& gen,
+                                std::vector<Vec3>& pozycje) {
+    const size_t n = sekwencja.length();
+    pozycje.clear();
+    if (n == 0) return true;
+    wyprobowane.assign(n, 0);
+
+    pozycje.push_back(Vec3{0, 0, 0});
+    siatka.wstaw(pozycje.back(), 0, sekwencja[0]);
+    size_t najglebszy = 1;
+    int restarty_wywolania = 0;
+
+    while (pozycje.size() < n) {
+        const size_t i = pozycje.size();
+        const Vec3 ostatni = pozycje.back();
+
+        // Kandydaci z wagą = liczba wolnych sąsiadów; ostatni aminokwas nie potrzebuje dalszej drogi
+        int wagi[6];
+        int suma_wag = 0;
+        for (int k = 0; k < 6; ++k) {
+            wagi[k] = 0;
+            if (wyprobowane[i] & (1 << k)) continue;
+            const Vec3 kandydat = ostatni + KIERUNKI[k];
+            if (!siatka.wolne(kandydat)) continue;
+            wagi[k] = i + 1 == n ? 1 : wolni_sasiedzi(siatka, kandydat);
+            suma_wag += wagi[k];
+        }
+
+        if (suma_wag == 0) {
+            // Ślepy zaułek: cofnięcie o jeden aminokwas albo restart, gdy cofanie sięga za głęboko
+            if (i <= 1 || najglebszy - (i - 1) > static_cast<size_t>(ustawienia.glebokosc_cofania)) {
+                for (const auto& p : pozycje) siatka.usun(p);
+                pozycje.clear();
+                ++restarty;
+                if (++restarty_wywolania > ustawienia.maks_restartow) return false;
+                std::fill(wyprobowane.begin(), wyprobowane.end(), 0);
+                pozycje.push_back(Vec3{0, 0, 0});
+                siatka.wstaw(pozycje.back(), 0, sekwencja[0]);
+                najglebszy = 1;
+                continue;
+            }
+            siatka.usun(ostatni);
+            pozycje.pop_back();
+            ++cofniecia;
+            continue;
+        }
+
+        int los = static_cast<int>(gen.ponizej(static_cast<uint32_t>(suma_wag)));
+        int k = 0;
+        while (los >= wagi[k]) los -= wagi[k++];
+        wyprobowane[i] |= static_cast<uint8_t>(1 << k);
+        if (i + 1 < n) wyprobowane[i + 1] = 0;
+
+        pozycje.push_back(ostatni + KIERUNKI[k]);
+        siatka.wstaw(pozycje.back(), i, sekwencja[i]);
+        najglebszy = std::max(najglebszy, pozycje.size());
+    }
+    return true;
+}
+
+std::vector<std::vector<Vec3>> GeneratorStartowy::generuj_wiele(const std::string& sekwencja, size_t liczba,
+                                                                uint64_t ziarno, size_t watki,
+                                                                const UstawieniaGeneratora& ustawienia) {
+    std::vector<std::vector<Vec3>> wyniki(liczba);
+    PulaWatkow pula(watki);
+
+    // Jeden blok konformacji na wątek - jedna siatka na blok
+    const size_t bloki = std::min(liczba, pula.liczba_watkow());
+    for (size_t b = 0; b < bloki; ++b) {
+        pula.dodaj([&, b] {
+            GeneratorStartowy generator(ustawienia);
+            SiatkaZajetosci siatka;
+            for (size_t k = b; k < liczba; k += bloki) {
+                Xoshiro256 gen(ziarno_przebiegu(ziarno, k));
+                generator.generuj(sekwencja, siatka, gen, wyniki[k]);
+                for (const auto& p : wyniki[k]) siatka.usun(p);
+                siatka.dopasuj({Vec3{0, 0, 0}});
+            }
+        });
+    }
+    pula.czekaj();
+    return wyniki;
+}
@@ -1,116 +1,312 @@
 #include "HP_model.h"
+#include "Trajektoria.h"
+#include "ZapisAsynchroniczny.h"
+#include "PunktKontrolny.h"
+#include "PamiecKonformacji.h"
+#include "Harmonogram.h"
+#include "StatystykiPrzebiegu.h"
+#include "GeneratorStartowy.h"
 #include <cmath>
 #include <iostream>
+#include <charconv>
+#include <filesystem>
 #include <fstream>
-#include <unordered_set>
+#include <functional>
 #include <random>
 #include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+/**
+ * Konstruktor domyślny: sekwencja ubikwityny w kodzie HP (przykład).
+ */
+template <typename Oddzialywanie>
+Model<Oddzialywanie>::Model()
+    : Model("PHPHHHHHPHPHPHHPPPPPHPPPPHHHPPPPPHPPPHHPHPHHHHPPPPHHHHPPHPHPHHHHHHHHHPPHHPP")
+{
+}
 
 /**
  * Konstruktor: ustawia sekwencję białka, inicjalizuje generator liczb losowych i zeruje statystyki.
  */
-HP_model::HP_model()
-    : gen(std::random_device{}()), dist_os(0,2), dist_kierunek(0,5), dist_ruch(0,2),
-      nieudane_koniec(0), nieudane_naroznik(0), nieudane_crankshaft(0)
+template <typename Oddzialywanie>
+Model<Oddzialywanie>::Model(const std::string& sekwencja)
+    : sekwencja_bialka(sekwencja), energia(0), tryb_propozycji(TrybPropozycji::WszystkieRuchy),
+      gadatliwosc(Gadatliwosc::Postep), interwal_raportu(1000), krok_zapisu_trajektorii(1),
+      katalog_wyjsciowy("."), polityka_zapisu(ZapisAsynchroniczny::Polityka::Blokuj),
+      co_ile_punkt_kontrolny(0), wznowienie(false), przebieg{0, 0.0, 0, 0},
+      pamiec_konformacji(nullptr), kara_tabu(0.0), klucz_biezacy{0, 0}, odwiedziny_biezace(0),
+      harmonogram(nullptr), detektor(nullptr), statystyki(nullptr), zapis_energii(true), zapis_plikow(true),
+      typ_ostatniego_ruchu(-1), kroki_przebiegu(0), najlepsza_energia_przebiegu(0),
+      gen((static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}()),
+      nieudane_koniec(0), nieudane_naroznik(0), nieudane_crankshaft(0), nieudane_pull(0), wykonane_kroki(0),
+      log_stosunek_propozycji(0.0)
 {
-    // Sekwencja ubikwityny w kodzie HP (przykład)
-    sekwencja_bialka = "PHPHHHHHPHPHPHHPPPPPHPPPPHHHPPPPPHPPPHHPHPHHHHPPPPHHHHPPHPHPHHHHHHHHHPPHHPP";
+    kody.reserve(sekwencja.size());
+    for (char litera : sekwencja) {
+        const int kod = Oddzialywanie::koduj(litera);
+        if (kod < 0) {
+            throw std::invalid_argument(std::string("Litera spoza alfabetu modelu: ") + litera);
+        }
+        kody.push_back(static_cast<uint8_t>(kod));
+    }
+    siatka.zarezerwuj(sekwencja.size());
+    ustaw_mieszanke_ruchow(1.0, 1.0, 1.0, 1.0);
     proponowane_koniec = zaakceptowane_koniec = 0;
     proponowane_naroznik = zaakceptowane_naroznik = 0;
     proponowane_crankshaft = zaakceptowane_crankshaft = 0;
+    proponowane_pull = zaakceptowane_pull = 0;
+}
+
+template <typename Oddzialywanie>
+void Model<Oddzialywanie>::ustaw_mieszanke_ruchow(double koniec, double naroznik, double crankshaft, double pull) {
+    const double wagi[4] = {koniec, naroznik, crankshaft, pull};
+    double suma = 0.0;
+    for (int k = 0; k < 4; ++k) {
+        suma += wagi[k];
+        mieszanka_ruchow[k] = suma;
+    }
+}
+
+template <typename Oddzialywanie>
+void Model<Oddzialywanie>::ustaw_ziarno(uint64_t ziarno) {
+    gen.ustaw_ziarno(ziarno);
+}
+
+template <typename Oddzialywanie>
+void Model<Oddzialywanie>::ustaw_strumien(uint64_t ziarno, uint64_t numer) {
+    gen = Xoshiro256::strumien(ziarno, numer);
 }
 
 /**
- * Inicjalizacja: generuje linię prostą lub losowy walk bez kolizji.
+ * Inicjalizacja: generuje linię prostą lub losowy łańcuch samounikający (GeneratorStartowy).
  */
-bool HP_model::generuj_startowa_konformacje(bool losowa, int max_proby) {
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::generuj_startowa_konformacje(bool losowa, int max_proby) {
+    wznowienie = false;
     pozycje.clear();
-    mapa_pozycji.clear();
-    std::vector<Vec3> mozliwe_ruchy = {
-        Vec3{1,0,0}, Vec3{-1,0,0}, Vec3{0,1,0}, Vec3{0,-1,0}, Vec3{0,0,1}, Vec3{0,0,-1}
-    };
+    siatka.wyczysc();
+    wykonane_kroki = 0;
+    bufor_stare.resize(sekwencja_bialka.length());
+    bufor_nowe.resize(sekwencja_bialka.length());
 
     if (!losowa) {
         // Linia prosta wzdłuż osi Z
         for (size_t i = 0; i < sekwencja_bialka.length(); ++i) {
             Vec3 pos = Vec3{0, 0, static_cast<int>(-i)};
             pozycje.push_back(pos);
-            mapa_pozycji[pos] = sekwencja_bialka[i];
+            siatka.wstaw(pos, i, sekwencja_bialka[i]);
         }
+        energia = energia_z_siatki();
         return true;
     }
 
-    // Losowy walk z unikaniem kolizji
-    pozycje.push_back(Vec3{0,0,0});
-    mapa_pozycji[pozycje.back()] = sekwencja_bialka[0];
-    for (size_t i = 1; i < sekwencja_bialka.length(); ++i) {
-        std::vector<Vec3> kandydaci;
-        Vec3 ostatni = pozycje.back();
-        for (const auto& ruch : mozliwe_ruchy) {
-            Vec3 nowy = ostatni + ruch;
-            if (mapa_pozycji.find(nowy) == mapa_pozycji.end())
-                kandydaci.push_back(nowy);
-        }
-        if (kandydaci.empty()) {
-            std::cerr << "Nie udało się wygenerować losowej konformacji, restartuję...\n";
+    // Wzrost z podglądem i ograniczonym cofaniem - nie utyka na długich łańcuchach
+    UstawieniaGeneratora ustawienia;
+    ustawienia.maks_restartow = max_proby;
+    GeneratorStartowy generator(ustawienia);
+    if (!generator.generuj(sekwencja_bialka, siatka, gen, pozycje)) {
+        HP_LOG(Gadatliwosc::Szczegoly, gadatliwosc, "Nie udało się wygenerować losowej konformacji\n");
+        return false;
+    }
+    energia = energia_z_siatki();
+    return true;
+}
+
+/**
+ * Ustawia konformację po sprawdzeniu wiązań i samounikania (przez siatkę).
+ */
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::ustaw_konformacje(const std::vector<Vec3>& nowe_pozycje) {
+    if (nowe_pozycje.size() != sekwencja_bialka.length()) return false;
+
+    siatka.wyczysc();
+    for (size_t i = 0; i < nowe_pozycje.size(); ++i) {
+        if ((i > 0 && odleglosc(nowe_pozycje[i - 1], nowe_pozycje[i]) != 1) || !siatka.wolne(nowe_pozycje[i])) {
+            odbuduj_siatke();
             return false;
         }
-        Vec3 wybrany = kandydaci[dist_kierunek(gen) % kandydaci.size()];
-        pozycje.push_back(wybrany);
-        mapa_pozycji[wybrany] = sekwencja_bialka[i];
+        siatka.wstaw(nowe_pozycje[i], i, sekwencja_bialka[i]);
     }
+    wznowienie = false;
+    wykonane_kroki = 0;
+    pozycje = nowe_pozycje;
+    siatka.dopasuj(pozycje);
+    bufor_stare.resize(pozycje.size());
+    bufor_nowe.resize(pozycje.size());
+    energia = energia_z_siatki();
     return true;
 }
 
 /**
  * Odległość Manhattan pomiędzy dwoma punktami.
  */
-int HP_model::odleglosc(const Vec3& a, const Vec3& b) const {
+template <typename Oddzialywanie>
+int Model<Oddzialywanie>::odleglosc(const Vec3& a, const Vec3& b) const {
     return std::abs(a.x - b.x) + std::abs(a.y - b.y) + std::abs(a.z - b.z);
 }
 
 /**
  * Sprawdza, czy dwa punkty są bezpośrednimi sąsiadami na siatce 3D.
  */
-bool HP_model::sa_sasiadami(const Vec3& a, const Vec3& b) const {
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::sa_sasiadami(const Vec3& a, const Vec3& b) const {
     return odleglosc(a, b) == 1;
 }
 
 /**
- * Energia HP: -1 za każdy niesąsiedni kontakt H-H.
+ * Energia: suma energii niesąsiednich kontaktów (dla HP -1 za każdy kontakt H-H).
  */
-double HP_model::oblicz_energie() const {
+template <typename Oddzialywanie>
+double Model<Oddzialywanie>::oblicz_energie() const {
     double energia = 0.0;
     for (size_t i = 0; i < pozycje.size(); ++i) {
-        if (sekwencja_bialka[i] != 'H') continue;
-        for (size_t j = i + 1; j < pozycje.size(); ++j) {
-            if (sekwencja_bialka[j] != 'H') continue;
-            if (std::abs(static_cast<int>(i) - static_cast<int>(j)) == 1) continue;
+        if (!Oddzialywanie::oddzialuje(kody[i])) continue;
+        for (size_t j = i + 2; j < pozycje.size(); ++j) {
             if (odleglosc(pozycje[i], pozycje[j]) == 1) {
-                energia -= 1.0;
+                energia += Oddzialywanie::energia(kody[i], kody[j]);
             }
         }
     }
     return energia;
 }
 
+/**
+ * Energia z siatki zajętości w czasie O(N): każdy kontakt widziany jest
+ * z obu końców, więc suma energii lokalnych jest dwukrotnością energii.
+ */
+template <typename Oddzialywanie>
+int Model<Oddzialywanie>::energia_z_siatki() const {
+    int suma = 0;
+    for (size_t i = 0; i < pozycje.size(); ++i) {
+        suma += energia_lokalna(i);
+    }
+    return suma / 2;
+}
+
+/**
+ * Energia niesąsiednich kontaktów aminokwasu i w bieżącej konformacji.
+ * Sprawdza tylko 6 węzłów wokół pozycje[i], więc działa w czasie O(1).
+ * Model HP czyta typ sąsiada z bitu komórki siatki; pozostałe polityki -
+ * z zakodowanej sekwencji i tabeli energii.
+ */
+template <typename Oddzialywanie>
+int Model<Oddzialywanie>::energia_lokalna(size_t i) const {
+    const uint8_t typ = kody[i];
+    if (!Oddzialywanie::oddzialuje(typ)) return 0;
+
+    int wynik = 0;
+    for (const auto& dir : KIERUNKI) {
+        int32_t k = siatka.komorka(pozycje[i] + dir);
+        if (k == SiatkaZajetosci::PUSTA) continue;
+        if constexpr (Oddzialywanie::MASKA_HH) {
+            if (!SiatkaZajetosci::hydrofobowy(k)) continue;
+        }
+        // Sąsiedzi w łańcuchu nie tworzą kontaktu
+        int j = SiatkaZajetosci::indeks_aminokwasu(k);
+        if (std::abs(j - static_cast<int>(i)) <= 1) continue;
+        if constexpr (Oddzialywanie::MASKA_HH) {
+            --wynik;
+        } else {
+            wynik += Oddzialywanie::energia(typ, kody[j]);
+        }
+    }
+    return wynik;
+}
+
+/**
+ * Energia kontaktów aminokwasów przesuwanych przez ruch (w bieżącym stanie).
+ * Kontakt dwóch przesuwanych aminokwasów (możliwy w pull move) liczony jest
+ * raz - od strony aminokwasu o mniejszym indeksie.
+ */
+template <typename Oddzialywanie>
+int Model<Oddzialywanie>::energia_przesunietych(const Ruch& ruch) const {
+    if (ruch.liczba <= 2) {
+        // Najwyżej dwa kolejne aminokwasy: kontakt między nimi nie istnieje
+        int wynik = 0;
+        for (int k = 0; k < ruch.liczba; ++k) {
+            wynik += energia_lokalna(ruch.pierwszy + k);
+        }
+        return wynik;
+    }
+
+    const int pierwszy = static_cast<int>(ruch.pierwszy);
+    int wynik = 0;
+    for (int i = pierwszy; i < pierwszy + ruch.liczba; ++i) {
+        const uint8_t typ = kody[i];
+        if (!Oddzialywanie::oddzialuje(typ)) continue;
+        for (const auto& dir : KIERUNKI) {
+            int32_t k = siatka.komorka(pozycje[i] + dir);
+            if (k == SiatkaZajetosci::PUSTA) continue;
+            if constexpr (Oddzialywanie::MASKA_HH) {
+                if (!SiatkaZajetosci::hydrofobowy(k)) continue;
+            }
+            int j = SiatkaZajetosci::indeks_aminokwasu(k);
+            if (std::abs(j - i) <= 1) continue;
+            if (j >= pierwszy && j < pierwszy + ruch.liczba && j < i) continue;
+            if constexpr (Oddzialywanie::MASKA_HH) {
+                --wynik;
+            } else {
+                wynik += Oddzialywanie::energia(typ, kody[j]);
+            }
+        }
+    }
+    return wynik;
+}
+
+/**
+ * Wykonuje ruch w miejscu: aktualizuje pozycje i siatkę zajętości.
+ * Najpierw zwalnia stare węzły, potem zajmuje nowe.
+ */
+template <typename Oddzialywanie>
+void Model<Oddzialywanie>::zastosuj_ruch(const Ruch& ruch) {
+    const Vec3* stare = stare_ruchu(ruch);
+    const Vec3* nowe = nowe_ruchu(ruch);
+    for (int k = 0; k < ruch.liczba; ++k) {
+        siatka.usun(stare[k]);
+    }
+    for (int k = 0; k < ruch.liczba; ++k) {
+        size_t i = ruch.pierwszy + k;
+        pozycje[i] = nowe[k];
+        siatka.wstaw(nowe[k], i, sekwencja_bialka[i]);
+    }
+}
+
+/**
+ * Cofa wykonany ruch na podstawie zapisanych starych węzłów.
+ */
+template <typename Oddzialywanie>
+void Model<Oddzialywanie>::cofnij_ruch(const Ruch& ruch) {
+    const Vec3* stare = stare_ruchu(ruch);
+    const Vec3* nowe = nowe_ruchu(ruch);
+    for (int k = 0; k < ruch.liczba; ++k) {
+        siatka.usun(nowe[k]);
+    }
+    for (int k = 0; k < ruch.liczba; ++k) {
+        size_t i = ruch.pierwszy + k;
+        pozycje[i] = stare[k];
+        siatka.wstaw(stare[k], i, sekwencja_bialka[i]);
+    }
+}
+
 /**
  * Sprawdza, czy dane pole jest wolne (niezajęte przez aminokwas).
  */
-bool HP_model::pole_wolne(const Vec3& pos) const {
-    return mapa_pozycji.find(pos) == mapa_pozycji.end();
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::pole_wolne(const Vec3& pos) const {
+    return siatka.wolne(pos);
 }
 
 /**
  * RADYKALNIE PRZEPROJEKTOWANA funkcja przesunięcia końca.
  * Bezpośrednio wyszukuje wszystkie wolne pozycje sąsiadujące z sąsiadem końca.
  */
-std::vector<Vec3> HP_model::ruch_przesun_koniec() {
-    const std::vector<Vec3> kierunki = {
-        Vec3{1,0,0}, Vec3{-1,0,0}, Vec3{0,1,0}, Vec3{0,-1,0}, Vec3{0,0,1}, Vec3{0,0,-1}
-    };
-    
-    std::vector<std::pair<size_t, Vec3>> mozliwe_ruchy;
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::ruch_przesun_koniec(Ruch& ruch) {
+    // Pojemność na najgorszy przypadek (tu: 5 wolnych węzłów przy każdym końcu),
+    // więc po pierwszym wywołaniu krok nie alokuje pamięci
+    kandydaci.clear();
+    kandydaci.reserve(10);
     
     // Sztuczne generowanie ruchów pierwszego aminokwasu
     if (pozycje.size() > 1) {
@@ -118,13 +314,13 @@ std::vector<Vec3> HP_model::ruch_przesun_koniec() {
         Vec3 drugi = pozycje[1]; // Drugi aminokwas (pozostaje na miejscu)
         
         // Szukamy wszystkich wolnych pozycji sąsiadujących z drugim aminokwasem
-        for (const auto& dir : kierunki) {
+        for (const auto& dir : KIERUNKI) {
             Vec3 kandydat = drugi + dir;
             
             // Sprawdź, czy kandydat jest wolny i nie jest aktualną pozycją pierwszego aminokwasu
             if (kandydat != pozycje[0] && pole_wolne(kandydat)) {
-                std::cout << "ZNALEZIONO ruch końca dla pierwszego aminokwasu!" << std::endl;
-                mozliwe_ruchy.push_back({indeks, kandydat});
+                HP_LOG(Gadatliwosc::Szczegoly, gadatliwosc, "ZNALEZIONO ruch końca dla pierwszego aminokwasu!\n");
+                kandydaci.push_back({0, 1, indeks, {pozycje[indeks]}, {kandydat}});
             }
         }
     }
@@ -135,40 +331,36 @@ std::vector<Vec3> HP_model::ruch_przesun_koniec() {
         Vec3 przedostatni = pozycje[indeks - 1]; // Przedostatni aminokwas (pozostaje na miejscu)
         
         // Szukamy wszystkich wolnych pozycji sąsiadujących z przedostatnim aminokwasem
-        for (const auto& dir : kierunki) {
+        for (const auto& dir : KIERUNKI) {
             Vec3 kandydat = przedostatni + dir;
             
             // Sprawdź, czy kandydat jest wolny i nie jest aktualną pozycją ostatniego aminokwasu
             if (kandydat != pozycje[indeks] && pole_wolne(kandydat)) {
-                std::cout << "ZNALEZIONO ruch końca dla ostatniego aminokwasu!" << std::endl;
-                mozliwe_ruchy.push_back({indeks, kandydat});
+                HP_LOG(Gadatliwosc::Szczegoly, gadatliwosc, "ZNALEZIONO ruch końca dla ostatniego aminokwasu!\n");
+                kandydaci.push_back({0, 1, indeks, {pozycje[indeks]}, {kandydat}});
             }
         }
     }
     
-    std::cout << "Możliwych ruchów końca: " << mozliwe_ruchy.size() << std::endl;
+    HP_LOG(Gadatliwosc::Szczegoly, gadatliwosc, "Możliwych ruchów końca: " << kandydaci.size() << "\n");
     
-    if (!mozliwe_ruchy.empty()) {
-        std::uniform_int_distribution<> rand_idx(0, mozliwe_ruchy.size() - 1);
-        auto wybrany_ruch = mozliwe_ruchy[rand_idx(gen)];
-        
-        std::vector<Vec3> nowa_konformacja = pozycje;
-        nowa_konformacja[wybrany_ruch.first] = wybrany_ruch.second;
-        return nowa_konformacja;
+    if (!kandydaci.empty()) {
+        ruch = kandydaci[gen.ponizej(static_cast<uint32_t>(kandydaci.size()))];
+        return true;
     }
     
     nieudane_koniec++;
-    return {};
+    return false;
 }
 
 /**
  * Obrót narożnika: losowo wybierz możliwy ruch narożnika.
  */
-std::vector<Vec3> HP_model::ruch_obrot_naroznika() {
-    std::vector<Vec3> mozliwe_ruchy = {
-        Vec3{1,0,0}, Vec3{-1,0,0}, Vec3{0,1,0}, Vec3{0,-1,0}, Vec3{0,0,1}, Vec3{0,0,-1}
-    };
-    std::vector<std::pair<size_t, Vec3>> mozliwosci; // (indeks, nowa_pozycja)
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::ruch_obrot_naroznika(Ruch& ruch) {
+    // Najwyżej jedna nowa pozycja na narożnik
+    kandydaci.clear();
+    kandydaci.reserve(pozycje.size());
 
     for (size_t i = 1; i < pozycje.size()-1; ++i) {
         Vec3 prev = pozycje[i-1];
@@ -178,47 +370,36 @@ std::vector<Vec3> HP_model::ruch_obrot_naroznika() {
         // Sprawdź, czy aminokwas jest w narożniku (sąsiedzi nie leżą w linii prostej)
         if (odleglosc(prev, next) == 2) {
             // Znajdź wszystkie możliwe nowe pozycje dla narożnika
-            for (const auto& dir : mozliwe_ruchy) {
+            for (const auto& dir : KIERUNKI) {
                 Vec3 kandydat = prev + dir;
                 // Kandydat musi być: wolny, różny od curr, połączony z prev i next
                 if (kandydat != curr && pole_wolne(kandydat) && 
                     sa_sasiadami(kandydat, prev) && sa_sasiadami(kandydat, next)) {
-                    mozliwosci.push_back({i, kandydat});
+                    kandydaci.push_back({1, 1, i, {curr}, {kandydat}});
                 }
             }
         }
     }
 
-    std::cout << "Możliwych ruchów narożnika: " << mozliwosci.size() << std::endl;
+    HP_LOG(Gadatliwosc::Szczegoly, gadatliwosc, "Możliwych ruchów narożnika: " << kandydaci.size() << "\n");
 
-    if (!mozliwosci.empty()) {
-        std::uniform_int_distribution<> rand_moz(0, static_cast<int>(mozliwosci.size())-1);
-        auto wybor = mozliwosci[rand_moz(gen)];
-        
-        std::vector<Vec3> nowa_pozycja = pozycje;
-        nowa_pozycja[wybor.first] = wybor.second;
-        return nowa_pozycja;
+    if (!kandydaci.empty()) {
+        ruch = kandydaci[gen.ponizej(static_cast<uint32_t>(kandydaci.size()))];
+        return true;
     }
 
     nieudane_naroznik++;
-    return {};
+    return false;
 }
 
 /**
  * Crankshaft: obracanie dwóch kolejnych aminokwasów.
  */
-std::vector<Vec3> HP_model::ruch_crankshaft() {
-    std::vector<Vec3> kierunki = {
-        Vec3{1,0,0}, Vec3{-1,0,0}, Vec3{0,1,0}, Vec3{0,-1,0}, Vec3{0,0,1}, Vec3{0,0,-1}
-    };
-    
-    struct Ruch {
-        size_t indeks_i;
-        Vec3 nowa_poz_i_plus_1;
-        Vec3 nowa_poz_i_plus_2;
-    };
-    
-    std::vector<Ruch> mozliwe_ruchy;
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::ruch_crankshaft(Ruch& ruch) {
+    // Najwyżej 5 innych ścieżek długości 3 między a i d
+    kandydaci.clear();
+    kandydaci.reserve(5 * pozycje.size());
     
     // Szukamy fragmentów 4 aminokwasów
     for (size_t i = 0; i + 3 < pozycje.size(); ++i) {
@@ -231,7 +412,7 @@ std::vector<Vec3> HP_model::ruch_crankshaft() {
         if (odleglosc(a, d) != 2 && odleglosc(a, d) != 3) continue;
         
         // Generujemy wszystkie możliwe nowe pozycje dla b i c
-        for (const auto& dir_b : kierunki) {
+        for (const auto& dir_b : KIERUNKI) {
             Vec3 nowe_b = a + dir_b;
             
             // Warunki dla nowego b
@@ -240,7 +421,7 @@ std::vector<Vec3> HP_model::ruch_crankshaft() {
                 continue;
             }
             
-            for (const auto& dir_c : kierunki) {
+            for (const auto& dir_c : KIERUNKI) {
                 Vec3 nowe_c = d + dir_c;
                 
                 // Warunki dla nowego c
@@ -249,122 +430,719 @@ std::vector<Vec3> HP_model::ruch_crankshaft() {
                     continue;
                 }
                 
-                mozliwe_ruchy.push_back({i, nowe_b, nowe_c});
+                kandydaci.push_back({2, 2, i+1, {b, c}, {nowe_b, nowe_c}});
             }
         }
     }
     
-    std::cout << "Możliwych ruchów crankshaft: " << mozliwe_ruchy.size() << std::endl;
+    HP_LOG(Gadatliwosc::Szczegoly, gadatliwosc, "Możliwych ruchów crankshaft: " << kandydaci.size() << "\n");
     
-    if (!mozliwe_ruchy.empty()) {
-        std::uniform_int_distribution<> rand_idx(0, mozliwe_ruchy.size() - 1);
-        auto wybrany_ruch = mozliwe_ruchy[rand_idx(gen)];
-        
-        std::vector<Vec3> nowa_konformacja = pozycje;
-        nowa_konformacja[wybrany_ruch.indeks_i + 1] = wybrany_ruch.nowa_poz_i_plus_1;
-        nowa_konformacja[wybrany_ruch.indeks_i + 2] = wybrany_ruch.nowa_poz_i_plus_2;
-        return nowa_konformacja;
+    if (!kandydaci.empty()) {
+        ruch = kandydaci[gen.ponizej(static_cast<uint32_t>(kandydaci.size()))];
+        return true;
     }
     
     nieudane_crankshaft++;
-    return {};
+    return false;
 }
 
 /**
- * Algorytm Metropolisa z symulowanym wyżarzaniem.
+ * Lokalne przesunięcie końca: losowy koniec i losowy kierunek od jego sąsiada.
  */
-void HP_model::algorytm_metropolisa(double T0, double T_inf, double alpha, int steps) {
-    double T = T0;
-    std::ofstream energy_file("energia.txt");
-    std::ofstream traj_file("trajektoria.txt");
-    std::ofstream koniec_file("koncowa_konformacja.txt");
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::lokalny_przesun_koniec(Ruch& ruch) {
+    if (pozycje.size() < 2) {
+        nieudane_koniec++;
+        return false;
+    }
+    size_t indeks = gen.ponizej(2) ? pozycje.size() - 1 : 0;
+    size_t sasiad = indeks == 0 ? 1 : indeks - 1;
+    Vec3 kandydat = pozycje[sasiad] + KIERUNKI[gen.ponizej(6)];
+
+    if (kandydat == pozycje[indeks] || !pole_wolne(kandydat)) {
+        nieudane_koniec++;
+        return false;
+    }
+    ruch = {0, 1, indeks, {pozycje[indeks]}, {kandydat}};
+    return true;
+}
+
+/**
+ * Lokalny obrót narożnika: losowy aminokwas wewnętrzny; jedyny możliwy nowy
+ * węzeł narożnika to prev + next - curr (dla linii prostej równy curr).
+ */
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::lokalny_obrot_naroznika(Ruch& ruch) {
+    if (pozycje.size() < 3) {
+        nieudane_naroznik++;
+        return false;
+    }
+    size_t i = 1 + gen.ponizej(static_cast<uint32_t>(pozycje.size() - 2));
+    Vec3 prev = pozycje[i-1];
+    Vec3 curr = pozycje[i];
+    Vec3 next = pozycje[i+1];
+    Vec3 kandydat = prev + next - curr;
+
+    if (kandydat == curr || !pole_wolne(kandydat)) {
+        nieudane_naroznik++;
+        return false;
+    }
+    ruch = {1, 1, i, {curr}, {kandydat}};
+    return true;
+}
+
+/**
+ * Lokalny crankshaft: losowy fragment 4 aminokwasów i losowa para kierunków
+ * dla b i c (36 wariantów), te same warunki co w ruch_crankshaft.
+ */
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::lokalny_crankshaft(Ruch& ruch) {
+    if (pozycje.size() < 4) {
+        nieudane_crankshaft++;
+        return false;
+    }
+    size_t i = gen.ponizej(static_cast<uint32_t>(pozycje.size() - 3));
+    Vec3 a = pozycje[i];
+    Vec3 b = pozycje[i+1];
+    Vec3 c = pozycje[i+2];
+    Vec3 d = pozycje[i+3];
+    Vec3 nowe_b = a + KIERUNKI[gen.ponizej(6)];
+    Vec3 nowe_c = d + KIERUNKI[gen.ponizej(6)];
+
+    if ((odleglosc(a, d) != 2 && odleglosc(a, d) != 3) ||
+        nowe_b == b || nowe_b == c || nowe_b == d || !pole_wolne(nowe_b) ||
+        nowe_c == a || nowe_c == b || nowe_c == c || nowe_c == nowe_b ||
+        !pole_wolne(nowe_c) || !sa_sasiadami(nowe_c, nowe_b)) {
+        nieudane_crankshaft++;
+        return false;
+    }
+    ruch = {2, 2, i+1, {b, c}, {nowe_b, nowe_c}};
+    return true;
+}
+
+/**
+ * Sprawdza wariant pull move i wyznacza węzły L (nowy węzeł aminokwasu i)
+ * oraz C (nowy węzeł jego sąsiada i - strona).
+ * Wewnątrz łańcucha: L sąsiaduje z kotwicą i + strona i leży po przekątnej
+ * względem i, C = i + (L - kotwica); C musi być wolny albo być węzłem i - strona.
+ * Na końcu łańcucha (brak kotwicy): C = i + kierunek1, L = C + kierunek2, oba wolne.
+ */
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::pull_legalny(const WariantPull& wariant, Vec3& L, Vec3& C) const {
+    const int n = static_cast<int>(pozycje.size());
+    const int i = static_cast<int>(wariant.i);
+    const int kotwica = i + wariant.strona;
+    const int ciagniety = i - wariant.strona;
+    const Vec3& e1 = KIERUNKI[wariant.kierunek1];
+
+    if (kotwica >= 0 && kotwica < n) {
+        const Vec3 d = pozycje[kotwica] - pozycje[i];
+        // Kierunek równoległy do wiązania nie daje węzła po przekątnej
+        if (e1 == d || pozycje[kotwica] + e1 == pozycje[i]) return false;
+        L = pozycje[kotwica] + e1;
+        C = pozycje[i] + e1;
+        if (!pole_wolne(L)) return false;
+        if (ciagniety < 0 || ciagniety >= n) return true;
+        return C == pozycje[ciagniety] || pole_wolne(C);
+    }
+
+    C = pozycje[i] + e1;
+    L = C + KIERUNKI[wariant.kierunek2];
+    return pole_wolne(C) && pole_wolne(L);
+}
+
+/**
+ * Buduje legalny pull move: i przechodzi do L, i - strona do C, a dalsze
+ * aminokwasy podążają za łańcuchem (j zajmuje stary węzeł j ± 2), aż
+ * któryś już sąsiaduje z nowym węzłem poprzednika. Przesunięte aminokwasy
+ * są kolejne; ich węzły trafiają do buforów modelu albo do samego ruchu.
+ */
+template <typename Oddzialywanie>
+void Model<Oddzialywanie>::zbuduj_pull(const WariantPull& wariant, const Vec3& L, const Vec3& C, Ruch& ruch) {
+    const int n = static_cast<int>(pozycje.size());
+    const int s = wariant.strona;
+    const int i = static_cast<int>(wariant.i);
+
+    // Nowe węzły w kolejności ciągnięcia: i, i - s, i - 2s, ...
+    int liczba = 0;
+    bufor_nowe[liczba++] = L;
+    int j = i - s;
+    if (j >= 0 && j < n && pozycje[j] != C) {
+        bufor_nowe[liczba++] = C;
+        for (j -= s; j >= 0 && j < n; j -= s) {
+            if (sa_sasiadami(pozycje[j], bufor_nowe[liczba - 1])) break;
+            bufor_nowe[liczba++] = pozycje[j + 2 * s];
+        }
+    }
+
+    // Porządek rosnących indeksów
+    const int pierwszy = s > 0 ? i - liczba + 1 : i;
+    if (s > 0) std::reverse(bufor_nowe.begin(), bufor_nowe.begin() + liczba);
+    std::copy(pozycje.begin() + pierwszy, pozycje.begin() + pierwszy + liczba, bufor_stare.begin());
+
+    ruch.typ = 3;
+    ruch.liczba = liczba;
+    ruch.pierwszy = static_cast<size_t>(pierwszy);
+    if (liczba <= 2) {
+        std::copy(bufor_stare.begin(), bufor_stare.begin() + liczba, ruch.stare);
+        std::copy(bufor_nowe.begin(), bufor_nowe.begin() + liczba, ruch.nowe);
+    }
+}
+
+/**
+ * Pull move: wylicza wszystkie legalne warianty i losuje jeden.
+ */
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::ruch_pull(Ruch& ruch) {
+    const size_t n = pozycje.size();
+    // Najwyżej 6 wariantów na aminokwas i stronę, 36 na końcach łańcucha
+    kandydaci_pull.clear();
+    kandydaci_pull.reserve(12 * n + 60);
+    Vec3 L, C;
+
+    for (size_t i = 0; n >= 3 && i < n; ++i) {
+        for (int strona : {1, -1}) {
+            // Na końcu łańcucha (brak kotwicy) wariant zależy też od drugiego kierunku
+            const bool koniec = (strona > 0 && i == n - 1) || (strona < 0 && i == 0);
+            for (int k1 = 0; k1 < 6; ++k1) {
+                for (int k2 = 0; k2 < (koniec ? 6 : 1); ++k2) {
+                    WariantPull wariant{i, strona, k1, k2};
+                    if (pull_legalny(wariant, L, C)) kandydaci_pull.push_back(wariant);
+                }
+            }
+        }
+    }
+
+    HP_LOG(Gadatliwosc::Szczegoly, gadatliwosc, "Możliwych pull moves: " << kandydaci_pull.size() << "\n");
+
+    if (!kandydaci_pull.empty()) {
+        const WariantPull& wariant = kandydaci_pull[gen.ponizej(static_cast<uint32_t>(kandydaci_pull.size()))];
+        pull_legalny(wariant, L, C);
+        zbuduj_pull(wariant, L, C, ruch);
+        return true;
+    }
+
+    nieudane_pull++;
+    return false;
+}
+
+/**
+ * Lokalny pull move: losowy aminokwas, strona i kierunki (stała liczba
+ * wariantów); nielegalny wariant jest odrzucany bez przeszukiwania.
+ */
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::lokalny_pull(Ruch& ruch) {
+    if (pozycje.size() < 3) {
+        nieudane_pull++;
+        return false;
+    }
+    WariantPull wariant;
+    wariant.i = gen.ponizej(static_cast<uint32_t>(pozycje.size()));
+    wariant.strona = gen.ponizej(2) ? 1 : -1;
+    wariant.kierunek1 = static_cast<int>(gen.ponizej(6));
+    wariant.kierunek2 = static_cast<int>(gen.ponizej(6));
 
-    double energia_poczatkowa = oblicz_energie();
-    std::cout << "Energia początkowa: " << energia_poczatkowa << std::endl;
+    Vec3 L, C;
+    if (!pull_legalny(wariant, L, C)) {
+        nieudane_pull++;
+        return false;
+    }
+    zbuduj_pull(wariant, L, C, ruch);
 
-    // Losowy wybór rodzaju ruchu
-    std::uniform_int_distribution<> dist_typ_ruchu(0, 2);
+    // Wariant na końcu łańcucha zależy od dwóch kierunków, wewnętrzny od jednego,
+    // więc jest 6 razy mniej prawdopodobny. Ruch odwrotny jest końcowy, gdy
+    // ciągnięcie dotarło do końca łańcucha; wtedy poprawka Metropolisa-Hastingsa.
+    const size_t n = pozycje.size();
+    const int kotwica = static_cast<int>(wariant.i) + wariant.strona;
+    const bool koncowy = kotwica < 0 || kotwica >= static_cast<int>(n);
+    const bool odwrotny_koncowy = ruch.liczba >= 2 &&
+        (wariant.strona > 0 ? ruch.pierwszy == 0 : ruch.pierwszy + ruch.liczba == n);
+    if (koncowy != odwrotny_koncowy) {
+        log_stosunek_propozycji = koncowy ? std::log(6.0) : -std::log(6.0);
+    }
+    return true;
+}
 
-    for (int step = 0; step < steps; ++step) {
-        int typ_ruchu = dist_typ_ruchu(gen);
-        std::vector<Vec3> nowa_konformacja;
+/**
+ * Losuje typ ruchu, proponuje ruch, wykonuje go w miejscu i wyznacza ΔE.
+ * @return false jeśli nie zaproponowano żadnego ruchu (konformacja bez zmian)
+ */
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::zaproponuj_ruch(Ruch& ruch, int& typ_ruchu, int& dE, bool mierz) {
+    // Typ ruchu z mieszanki: pierwszy przedział skumulowanych wag zawierający r
+    const double r = gen.jednostajna() * mieszanka_ruchow[3];
+    typ_ruchu = 0;
+    while (typ_ruchu < 3 && r >= mieszanka_ruchow[typ_ruchu]) ++typ_ruchu;
+    log_stosunek_propozycji = 0.0;
+    bool zaproponowano;
+    bool lokalny = tryb_propozycji == TrybPropozycji::Lokalny;
 
+    {
+        Telemetria::Pomiar pomiar(telemetria, Telemetria::Propozycja, mierz);
         if (typ_ruchu == 0) {
             ++proponowane_koniec;
-            nowa_konformacja = ruch_przesun_koniec();
+            zaproponowano = lokalny ? lokalny_przesun_koniec(ruch) : ruch_przesun_koniec(ruch);
         } else if (typ_ruchu == 1) {
             ++proponowane_naroznik;
-            nowa_konformacja = ruch_obrot_naroznika();
-        } else {
+            zaproponowano = lokalny ? lokalny_obrot_naroznika(ruch) : ruch_obrot_naroznika(ruch);
+        } else if (typ_ruchu == 2) {
             ++proponowane_crankshaft;
-            nowa_konformacja = ruch_crankshaft();
+            zaproponowano = lokalny ? lokalny_crankshaft(ruch) : ruch_crankshaft(ruch);
+        } else {
+            ++proponowane_pull;
+            zaproponowano = lokalny ? lokalny_pull(ruch) : ruch_pull(ruch);
         }
+    }
+    if (!zaproponowano) return false;
 
-        if (!nowa_konformacja.empty()) {
-            double E_old = oblicz_energie();
-            
-            // Zapamiętaj starą pozycję na wypadek odrzucenia ruchu
-            auto kopia_pozycji = pozycje;
-            
-            // Zaktualizuj pozycje i mapę pozycji
-            pozycje = nowa_konformacja;
-            mapa_pozycji.clear();
-            for (size_t i = 0; i < pozycje.size(); ++i) {
-                mapa_pozycji[pozycje[i]] = sekwencja_bialka[i];
+    // Kontakty przesuwanych aminokwasów przed ruchem
+    int energia_przed;
+    {
+        Telemetria::Pomiar pomiar(telemetria, Telemetria::Energia, mierz);
+        energia_przed = energia_przesunietych(ruch);
+    }
+    
+    // Wykonaj ruch w miejscu; ruch sam jest zapisem do cofnięcia
+    {
+        Telemetria::Pomiar pomiar(telemetria, Telemetria::Siatka, mierz);
+        zastosuj_ruch(ruch);
+    }
+    
+    // ΔE wynika wyłącznie z kontaktów przesuniętych aminokwasów
+    Telemetria::Pomiar pomiar(telemetria, Telemetria::Energia, mierz);
+    dE = energia_przesunietych(ruch) - energia_przed;
+    return true;
+}
+
+/**
+ * Zatwierdza wykonany ruch (energia += ΔE) albo go cofa.
+ */
+template <typename Oddzialywanie>
+void Model<Oddzialywanie>::zakoncz_ruch(const Ruch& ruch, int typ_ruchu, int dE, bool akceptacja, bool mierz) {
+    if (akceptacja) {
+        // Ruch zaakceptowany
+        energia += dE;
+        if (typ_ruchu == 0) ++zaakceptowane_koniec;
+        else if (typ_ruchu == 1) ++zaakceptowane_naroznik;
+        else if (typ_ruchu == 2) ++zaakceptowane_crankshaft;
+        else ++zaakceptowane_pull;
+    } else {
+        // Ruch odrzucony - przywróć poprzednią konformację
+        Telemetria::Pomiar pomiar(telemetria, Telemetria::Siatka, mierz);
+        cofnij_ruch(ruch);
+    }
+}
+
+/**
+ * Czynności po każdym kroku: okresowe dopasowanie siatki i kontrola energii.
+ */
+template <typename Oddzialywanie>
+void Model<Oddzialywanie>::po_kroku() {
+    // Okresowe dopasowanie siatki do dryfującego łańcucha
+    if (wykonane_kroki++ % 1024 == 0) {
+        siatka.dopasuj(pozycje);
+    }
+
+#ifdef HP_SPRAWDZ_ENERGIE
+    // Kontrola spójności energii przyrostowej z pełnym przeliczeniem
+    if (energia != static_cast<int>(oblicz_energie())) {
+        std::cerr << "Niespójna energia w kroku " << wykonane_kroki - 1 << ": przyrostowa "
+                  << energia << ", pełna " << oblicz_energie() << std::endl;
+        std::abort();
+    }
+#endif
+}
+
+/**
+ * Kryterium Metropolisa dla całkowitego ΔE z poprawką Hastingsa.
+ */
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::akceptuj_metropolis(int dE, double log_stosunek, double T) {
+    if (log_stosunek != 0.0) {
+        // Rzadki przypadek: pull move z poprawką Hastingsa - pełna formuła
+        const double log_akceptacji = -dE/T + log_stosunek;
+        return log_akceptacji >= 0.0 || gen.jednostajna() < std::exp(log_akceptacji);
+    }
+    // Całkowite ΔE: porównanie losowych bitów z progiem z tablicy (bez exp)
+    return dE <= 0 || gen() < tablica_akceptacji.prog(dE, T);
+}
+
+/**
+ * Pojedynczy krok Metropolisa w temperaturze T.
+ */
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::krok_mc(double T, bool mierz) {
+    return krok([&](int dE, double log_stosunek) {
+        return akceptuj_metropolis(dE, log_stosunek, T);
+    }, mierz);
+}
+
+/**
+ * Krok Metropolisa z rejestracją odwiedzonej konformacji w pamięci.
+ * Klucz (O(N)) liczony jest tylko dla zaakceptowanych ruchów, a przy karze
+ * tabu - dla każdej propozycji, bo kryterium potrzebuje liczby jej odwiedzin.
+ */
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::krok_z_pamiecia(double T, long long numer_kroku, bool mierz) {
+    KluczKonformacji klucz_proponowany = klucz_biezacy;
+    const bool akceptacja = krok([&](int dE, double log_stosunek) {
+        if (kara_tabu == 0.0) return akceptuj_metropolis(dE, log_stosunek, T);
+
+        // Ruch jest już zastosowany w pozycjach - klucz opisuje proponowaną konformację
+        klucz_proponowany = klucz_konformacji(pozycje);
+        WpisKonformacji wpis;
+        const double odwiedziny = pamiec_konformacji->znajdz(klucz_proponowany, wpis) ? wpis.odwiedziny : 0.0;
+        const double log_akceptacji = -(dE + kara_tabu * (odwiedziny - odwiedziny_biezace)) / T + log_stosunek;
+        return log_akceptacji >= 0.0 || gen.jednostajna() < std::exp(log_akceptacji);
+    }, mierz);
+
+    if (akceptacja) {
+        klucz_biezacy = kara_tabu == 0.0 ? klucz_konformacji(pozycje) : klucz_proponowany;
+    }
+    odwiedziny_biezace = pamiec_konformacji->odwiedz(klucz_biezacy, energia, numer_kroku).odwiedziny;
+    return akceptacja;
+}
+
+/**
+ * Zapisuje punkt kontrolny: stan przebiegu, konformację, statystyki,
+ * pełny stan generatora i mieszankę ruchów.
+ */
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::zapisz_punkt_kontrolny(const StanPrzebiegu& stan) const {
+    ZapisBinarny zapis;
+    zapis.tekst(sekwencja_bialka);
+    zapis.i64(stan.krok);
+    zapis.f64(stan.T);
+    zapis.u64(stan.dlugosc_energii);
+    zapis.u64(stan.dlugosc_trajektorii);
+    zapis.i32(krok_zapisu_trajektorii);
+    zapis.u32(static_cast<uint32_t>(tryb_propozycji));
+    for (int k = 0; k < 4; ++k) zapis.u64(gen.stan(k));
+    for (double waga : mieszanka_ruchow) zapis.f64(waga);
+
+    zapis.i32(energia);
+    zapis.u32(static_cast<uint32_t>(pozycje.size()));
+    for (const auto& p : pozycje) {
+        zapis.i32(p.x);
+        zapis.i32(p.y);
+        zapis.i32(p.z);
+    }
+
+    for (int licznik : {proponowane_koniec, zaakceptowane_koniec, proponowane_naroznik, zaakceptowane_naroznik,
+                        proponowane_crankshaft, zaakceptowane_crankshaft, proponowane_pull, zaakceptowane_pull,
+                        nieudane_koniec, nieudane_naroznik, nieudane_crankshaft, nieudane_pull}) {
+        zapis.i32(licznik);
+    }
+    zapis.i64(wykonane_kroki);
+    zapis.i32(najlepsza_energia_przebiegu);
+    zapis.u32(static_cast<uint32_t>(najlepsze_pozycje.size()));
+    for (const auto& p : najlepsze_pozycje) {
+        zapis.i32(p.x);
+        zapis.i32(p.y);
+        zapis.i32(p.z);
+    }
+
+    // Sekcje opcjonalne z flagą obecności (harmonogram - z nazwą rodzaju, pusta - brak);
+    // przy wczytywaniu muszą być ustawione te same
+    zapis.tekst(harmonogram ? harmonogram->rodzaj() : "");
+    if (harmonogram) harmonogram->zapisz_stan(zapis);
+    zapis.u32(detektor != nullptr);
+    if (detektor) detektor->zapisz_stan(zapis);
+    zapis.u32(statystyki != nullptr);
+    if (statystyki) statystyki->zapisz_stan(zapis);
+    zapis.u32(pamiec_konformacji != nullptr);
+    if (pamiec_konformacji) pamiec_konformacji->zapisz_stan(zapis);
+    return punkt_kontrolny::zapisz_atomowo(sciezka_punktu_kontrolnego, zapis.zakoncz());
+}
+
+template <typename Oddzialywanie>
+bool Model<Oddzialywanie>::wczytaj_punkt_kontrolny(const std::string& sciezka) {
+    OdczytBinarny odczyt;
+    if (!odczyt.otworz(sciezka) || odczyt.tekst() != sekwencja_bialka) return false;
+
+    StanPrzebiegu stan;
+    stan.krok = odczyt.i64();
+    stan.T = odczyt.f64();
+    stan.dlugosc_energii = odczyt.u64();
+    stan.dlugosc_trajektorii = odczyt.u64();
+    const int krok_zapisu = odczyt.i32();
+    const uint32_t tryb = odczyt.u32();
+
+    // Stan wczytywany do kopii - model zmieniany dopiero po pełnym odczycie
+    Xoshiro256 nowy_gen;
+    for (int k = 0; k < 4; ++k) nowy_gen.ustaw_stan(k, odczyt.u64());
+    double nowa_mieszanka[4];
+    for (double& waga : nowa_mieszanka) waga = odczyt.f64();
+
+    const int nowa_energia = odczyt.i32();
+    const uint32_t n = odczyt.u32();
+    if (!odczyt.ok() || n != sekwencja_bialka.size()) return false;
+    std::vector<Vec3> nowe_pozycje(n);
+    for (auto& p : nowe_pozycje) {
+        p.x = odczyt.i32();
+        p.y = odczyt.i32();
+        p.z = odczyt.i32();
+    }
+    int liczniki[12];
+    for (int& licznik : liczniki) licznik = odczyt.i32();
+    const long long kroki = odczyt.i64();
+    const int nowa_najlepsza = odczyt.i32();
+    const uint32_t m = odczyt.u32();
+    if (!odczyt.ok() || (m != 0 && m != n)) return false;
+    std::vector<Vec3> nowe_najlepsze(m);
+    for (auto& p : nowe_najlepsze) {
+        p.x = odczyt.i32();
+        p.y = odczyt.i32();
+        p.z = odczyt.i32();
+    }
+    if (!odczyt.ok()) return false;
+
+    // Sekcje opcjonalne: flaga obecności musi zgadzać się z bieżącymi ustawieniami.
+    // Stan trafia do kopii; funkcje ustawiające wywoływane są po odczycie całego pliku.
+    std::vector<std::function<void()>> ustaw;
+    auto sekcja = [&](bool zgodna, bool obecna, auto&& odczytaj) {
+        if (!zgodna || !odczyt.ok()) return false;
+        if (!obecna) return true;
+        std::function<void()> f = odczytaj();
+        if (!f) return false;
+        ustaw.push_back(std::move(f));
+        return true;
+    };
+    auto flaga = [&](const void* obiekt) { return (odczyt.u32() != 0) == (obiekt != nullptr); };
+    if (!sekcja(odczyt.tekst() == (harmonogram ? harmonogram->rodzaj() : ""), harmonogram != nullptr,
+                [&] { return harmonogram->odczytaj_stan(odczyt); }) ||
+        !sekcja(flaga(detektor), detektor != nullptr, [&] { return detektor->odczytaj_stan(odczyt); }) ||
+        !sekcja(flaga(statystyki), statystyki != nullptr, [&] { return statystyki->odczytaj_stan(odczyt); }) ||
+        !sekcja(flaga(pamiec_konformacji), pamiec_konformacji != nullptr,
+                [&] { return pamiec_konformacji->odczytaj_stan(odczyt); }) ||
+        !odczyt.ok() || !odczyt.na_koncu()) {
+        return false;
+    }
+    for (auto& f : ustaw) f();
+
+    przebieg = stan;
+    krok_zapisu_trajektorii = krok_zapisu;
+    tryb_propozycji = static_cast<TrybPropozycji>(tryb);
+    gen = nowy_gen;
+    std::copy(nowa_mieszanka, nowa_mieszanka + 4, mieszanka_ruchow);
+    energia = nowa_energia;
+    pozycje = nowe_pozycje;
+    int* cele[12] = {&proponowane_koniec, &zaakceptowane_koniec, &proponowane_naroznik, &zaakceptowane_naroznik,
+                     &proponowane_crankshaft, &zaakceptowane_crankshaft, &proponowane_pull, &zaakceptowane_pull,
+                     &nieudane_koniec, &nieudane_naroznik, &nieudane_crankshaft, &nieudane_pull};
+    for (int k = 0; k < 12; ++k) *cele[k] = liczniki[k];
+    wykonane_kroki = kroki;
+    najlepsza_energia_przebiegu = nowa_najlepsza;
+    najlepsze_pozycje = std::move(nowe_najlepsze);
+
+    odbuduj_siatke();
+    wznowienie = true;
+    return true;
+}
+
+/**
+ * Odtwarza siatkę zajętości i bufory ruchów z bieżących pozycji.
+ */
+template <typename Oddzialywanie>
+void Model<Oddzialywanie>::odbuduj_siatke() {
+    siatka.wyczysc();
+    for (size_t i = 0; i < pozycje.size(); ++i) {
+        siatka.wstaw(pozycje[i], i, sekwencja_bialka[i]);
+    }
+    siatka.dopasuj(pozycje);
+    bufor_stare.resize(pozycje.size());
+    bufor_nowe.resize(pozycje.size());
+}
+
+/**
+ * Algorytm Metropolisa z symulowanym wyżarzaniem.
+ */
+template <typename Oddzialywanie>
+void Model<Oddzialywanie>::algorytm_metropolisa(double T0, double T_inf, double alpha, int steps) {
+    double T = T0;
+    int pierwszy_krok = 0;
+    if (wznowienie) {
+        T = przebieg.T;
+        pierwszy_krok = static_cast<int>(przebieg.krok);
+        HP_LOG(Gadatliwosc::Postep, gadatliwosc, "Wznowienie od kroku " << pierwszy_krok << "\n");
+    }
+
+    // Strumienie wyjściowe zapisywane w tle bezpośrednio do katalogu wyjściowego
+    namespace fs = std::filesystem;
+    const fs::path katalog(katalog_wyjsciowy);
+    const size_t rozmiar_klatki = trajektoria::rozmiar_klatki(pozycje.size());
+    const bool pliki = zapis_plikow;
+    ZapisAsynchroniczny zapis(pliki ? 16 : 2, pliki ? std::max<size_t>(size_t(1) << 16, rozmiar_klatki) : 0);
+    zapis.ustaw_polityke(polityka_zapisu);
+    std::vector<uint8_t> klatka;
+    if (pliki) {
+        if ((zapis_energii && !zapis.otworz(ZapisAsynchroniczny::Energia, (katalog / "energia.txt").string(),
+                                            wznowienie ? przebieg.dlugosc_energii : 0)) ||
+            !zapis.otworz(ZapisAsynchroniczny::Trajektoria, (katalog / "trajektoria.bin").string(),
+                          wznowienie ? przebieg.dlugosc_trajektorii : 0) ||
+            !zapis.otworz(ZapisAsynchroniczny::Konformacja, (katalog / "koncowa_konformacja.txt").string())) {
+            std::cerr << "Nie można otworzyć plików wynikowych w katalogu " << katalog_wyjsciowy << std::endl;
+        }
+        klatka = trajektoria::koduj_naglowek(sekwencja_bialka, krok_zapisu_trajektorii);
+        if (!wznowienie) {
+            zapis.zapisz(ZapisAsynchroniczny::Trajektoria, klatka.data(), klatka.size(), true);
+        }
+        klatka.assign(rozmiar_klatki, 0);
+        zapis.rozpocznij();
+    }
+
+    // Energia liczona w pełni tylko raz; dalej aktualizowana o ΔE
+    energia = energia_z_siatki();
+    HP_LOG(Gadatliwosc::Postep, gadatliwosc, "Energia początkowa: " << energia << "\n");
+
+    if (pamiec_konformacji) {
+        // Po wznowieniu pamięć z punktu kontrolnego ma już odwiedziny bieżącej konformacji
+        klucz_biezacy = klucz_konformacji(pozycje);
+        WpisKonformacji wpis;
+        if (wznowienie && pamiec_konformacji->znajdz(klucz_biezacy, wpis)) {
+            odwiedziny_biezace = wpis.odwiedziny;
+        } else {
+            odwiedziny_biezace = pamiec_konformacji->odwiedz(klucz_biezacy, energia, pierwszy_krok).odwiedziny;
+        }
+    }
+
+    // Bez ustawionego harmonogramu - chłodzenie geometryczne z argumentów
+    HarmonogramGeometryczny geometryczny(alpha, T_inf);
+    HarmonogramTemperatury& harm = harmonogram ? *harmonogram : geometryczny;
+    if (!wznowienie) {
+        harm.rozpocznij(T0);
+        if (detektor) detektor->rozpocznij();
+        najlepsza_energia_przebiegu = energia;
+        najlepsze_pozycje = pozycje;
+        if (statystyki) statystyki->wyczysc();
+    }
+
+    telemetria.rozpocznij();
+    wznowienie = false;
+    int ostatni_krok = pierwszy_krok - 1;
+    bool przywroc_najlepsza = false;
+    for (int step = pierwszy_krok; step < steps; ++step) {
+        // Punkt kontrolny: stan przed krokiem `step`, po zapisaniu wszystkich wcześniejszych rekordów
+        if (co_ile_punkt_kontrolny > 0 && step > pierwszy_krok && step % co_ile_punkt_kontrolny == 0) {
+            zapis.oproznij();
+            const StanPrzebiegu stan{step, T, zapis.get_dlugosc(ZapisAsynchroniczny::Energia),
+                                     zapis.get_dlugosc(ZapisAsynchroniczny::Trajektoria)};
+            if (!zapisz_punkt_kontrolny(stan)) {
+                std::cerr << "Nie można zapisać punktu kontrolnego " << sciezka_punktu_kontrolnego << std::endl;
             }
-            
-            double E_new = oblicz_energie();
-            
-            // POPRAWIONA formuła akceptacji Metropolisa
-            if (E_new <= E_old || 
-                std::uniform_real_distribution<>(0,1)(gen) < std::exp(-(E_new-E_old)/T)) {
-                // Ruch zaakceptowany
-                if (typ_ruchu == 0) ++zaakceptowane_koniec;
-                else if (typ_ruchu == 1) ++zaakceptowane_naroznik;
-                else ++zaakceptowane_crankshaft;
-            } else {
-                // Ruch odrzucony - przywróć poprzednią konformację
-                pozycje = kopia_pozycji;
-                mapa_pozycji.clear();
-                for (size_t i = 0; i < pozycje.size(); ++i) {
-                    mapa_pozycji[pozycje[i]] = sekwencja_bialka[i];
-                }
+        }
+
+        const bool mierz = telemetria.probkuj(step);
+        const int energia_przed = energia;
+        const bool zaakceptowano = pamiec_konformacji ? krok_z_pamiecia(T, step, mierz) : krok_mc(T, mierz);
+        ostatni_krok = step;
+
+        // Schładzanie temperatury (symulowane wyżarzanie)
+        const KrokWyzarzania opis{step, energia, energia - energia_przed, zaakceptowano};
+        T = harm.nastepna(T, opis);
+        if (statystyki) statystyki->dodaj(step, energia, typ_ostatniego_ruchu, zaakceptowano, pozycje);
+
+        {
+            Telemetria::Pomiar pomiar(telemetria, Telemetria::Wyjscie, mierz);
+
+            // Zapisz energię i (co krok_zapisu_trajektorii) klatkę trajektorii
+            if (pliki && zapis_energii) {
+                char linia[16];
+                char* koniec_linii = std::to_chars(linia, linia + sizeof(linia) - 1, energia).ptr;
+                *koniec_linii++ = '\n';
+                zapis.zapisz(ZapisAsynchroniczny::Energia, linia, koniec_linii - linia);
+            }
+            if (pliki && step % krok_zapisu_trajektorii == 0) {
+                trajektoria::koduj_klatke(step, energia, pozycje, klatka.data());
+                zapis.zapisz(ZapisAsynchroniczny::Trajektoria, klatka.data(), rozmiar_klatki);
+            }
+
+            // Co interwal_raportu kroków wypisz informację o postępie
+            if (interwal_raportu > 0 && step % interwal_raportu == 0) {
+                HP_LOG(Gadatliwosc::Postep, gadatliwosc,
+                       "Krok " << step << ", temperatura: " << T
+                       << ", energia: " << energia
+                       << ", kroków/s: " << static_cast<long>(telemetria.kroki_na_sekunde(step - pierwszy_krok)) << "\n");
             }
         }
-        
-        // Zapisz energię i pozycje do plików
-        energy_file << oblicz_energie() << "\n";
-        for (const auto& poz : pozycje) {
-            traj_file << poz.x << " " << poz.y << " " << poz.z << " ";
+
+        // Najlepsza konformacja przebiegu (wyżarzanie może ją opuścić, restart - nadpisać)
+        if (energia < najlepsza_energia_przebiegu) {
+            najlepsza_energia_przebiegu = energia;
+            najlepsze_pozycje = pozycje;
         }
-        traj_file << "\n";
-        
-        // Schładzanie temperatury (symulowane wyżarzanie)
-        T = std::max(alpha*T, T_inf);
-        
-        // Co 1000 kroków wypisz informację o postępie
-        if (step % 1000 == 0) {
-            std::cout << "Krok " << step << ", temperatura: " << T 
-                      << ", energia: " << oblicz_energie() << std::endl;
+
+        // Zbieżność
+        if (detektor) {
+            const DetektorZbieznosci::Decyzja decyzja = detektor->obserwuj(opis);
+            if (decyzja == DetektorZbieznosci::Decyzja::Zakoncz) {
+                HP_LOG(Gadatliwosc::Postep, gadatliwosc, "Zbieżność w kroku " << step << ", koniec przebiegu\n");
+                break;
+            }
+            if (decyzja == DetektorZbieznosci::Decyzja::Restart) {
+                HP_LOG(Gadatliwosc::Postep, gadatliwosc, "Zbieżność w kroku " << step << ", restart "
+                       << detektor->get_restarty() << " (najlepsza energia " << najlepsza_energia_przebiegu << ")\n");
+                bool sukces = false;
+                for (int proba = 0; proba < 1000 && !sukces; ++proba) {
+                    sukces = generuj_startowa_konformacje(true);
+                }
+                if (!sukces) {
+                    przywroc_najlepsza = true;
+                    break;
+                }
+                T = T0;
+                harm.rozpocznij(T0);
+                if (pamiec_konformacji) {
+                    klucz_biezacy = klucz_konformacji(pozycje);
+                    odwiedziny_biezace = pamiec_konformacji->odwiedz(klucz_biezacy, energia, step).odwiedziny;
+                }
+            }
         }
     }
+    telemetria.zakoncz(ostatni_krok + 1 - pierwszy_krok);
+    kroki_przebiegu = ostatni_krok + 1;
+
+    // Po restartach wynikiem jest najlepsza konformacja całego przebiegu
+    if (detektor && !najlepsze_pozycje.empty() && (przywroc_najlepsza || najlepsza_energia_przebiegu < energia)) {
+        pozycje = najlepsze_pozycje;
+        odbuduj_siatke();
+        energia = najlepsza_energia_przebiegu;
+        przywroc_najlepsza = true;
+    }
+
+    // Ostatnia klatka trajektorii zawsze odpowiada końcowej konformacji
+    if (pliki && ostatni_krok >= 0 && (przywroc_najlepsza || ostatni_krok % krok_zapisu_trajektorii != 0)) {
+        trajektoria::koduj_klatke(ostatni_krok, energia, pozycje, klatka.data());
+        zapis.zapisz(ZapisAsynchroniczny::Trajektoria, klatka.data(), rozmiar_klatki, true);
+    }
     
     // Zapisz końcową konformację
-    for (const auto& poz : pozycje) {
-        koniec_file << poz.x << " " << poz.y << " " << poz.z << "\n";
+    if (pliki) {
+        std::string konformacja;
+        for (const auto& poz : pozycje) {
+            konformacja += std::to_string(poz.x) + " " + std::to_string(poz.y) + " " + std::to_string(poz.z) + "\n";
+        }
+        zapis.zapisz(ZapisAsynchroniczny::Konformacja, konformacja.data(), konformacja.size(), true);
+    }
+    zapis.zakoncz();
+    if (zapis.get_pominiete() > 0) {
+        HP_LOG(Gadatliwosc::Postep, gadatliwosc,
+               "Pominięto rekordów wyjścia (dysk nie nadążał): " << zapis.get_pominiete() << "\n");
     }
     
-    energy_file.close();
-    traj_file.close();
-    koniec_file.close();
-    
-    std::cout << "Energia końcowa: " << oblicz_energie() << std::endl;
+    if (pliki && statystyki) {
+        std::ofstream plik_statystyk(katalog / "statystyki.txt");
+        statystyki->zapisz_podsumowanie(plik_statystyk);
+    }
+
+    HP_LOG(Gadatliwosc::Postep, gadatliwosc, "Energia końcowa: " << energia << "\n");
 }
 
 /**
- * Wypisuje statystyki ruchów po zakończeniu symulacji.
+ * Wypisuje statystyki ruchów oraz telemetrię ostatniego przebiegu.
  */
-void HP_model::wypisz_statystyki() const {
+template <typename Oddzialywanie>
+void Model<Oddzialywanie>::wypisz_statystyki() const {
     std::cout << "Przesunięcia końca: proponowane " << proponowane_koniec
               << ", zaakceptowane " << zaakceptowane_koniec
               << ", nieudane próby: " << nieudane_koniec << "\n";
@@ -374,4 +1152,13 @@ void HP_model::wypisz_statystyki() const {
     std::cout << "Obroty crankshaft: proponowane " << proponowane_crankshaft
               << ", zaakceptowane " << zaakceptowane_crankshaft
               << ", nieudane próby: " << nieudane_crankshaft << "\n";
+    std::cout << "Pull moves: proponowane " << proponowane_pull
+              << ", zaakceptowane " << zaakceptowane_pull
+              << ", nieudane próby: " << nieudane_pull << "\n";
+    telemetria.raport(std::cout);
 }
+
+// Jawne instancje modelu dla dostępnych polityk oddziaływań
+template class Model<OddzialywanieHP>;
+template class Model<OddzialywanieHPNX>;
+template class Model<OddzialywanieMJ>;
@@ -0,0 +1,143 @@
+#include "Harmonogram.h"
+#include <cmath>
+#include <limits>
+
+HarmonogramAdaptacyjny::HarmonogramAdaptacyjny(double alpha, double T_inf, double cel_akceptacji, long long okno)
+    : alpha(alpha), T_inf(T_inf), cel_akceptacji(cel_akceptacji), okno(okno > 0 ? okno : 1),
+      czynnik(alpha), kroki_w_oknie(0), zaakceptowane_w_oknie(0)
+{
+}
+
+void HarmonogramAdaptacyjny::rozpocznij(double) {
+    czynnik = alpha;
+    kroki_w_oknie = zaakceptowane_w_oknie = 0;
+}
+
+double HarmonogramAdaptacyjny::nastepna(double T, const KrokWyzarzania& krok) {
+    zaakceptowane_w_oknie += krok.zaakceptowano && krok.zmiana_energii != 0;
+    if (++kroki_w_oknie == okno) {
+        const double akceptacja = static_cast<double>(zaakceptowane_w_oknie) / okno;
+        const double wykladnik = std::min(4.0, std::max(0.25, akceptacja / cel_akceptacji));
+        czynnik = std::pow(alpha, wykladnik);
+        kroki_w_oknie = zaakceptowane_w_oknie = 0;
+    }
+    return std::max(czynnik * T, T_inf);
+}
+
+void HarmonogramAdaptacyjny::zapisz_stan(ZapisBinarny& zapis) const {
+    zapis.f64(czynnik);
+    zapis.i64(kroki_w_oknie);
+    zapis.i64(zaakceptowane_w_oknie);
+}
+
+std::function<void()> HarmonogramAdaptacyjny::odczytaj_stan(OdczytBinarny& odczyt) {
+    HarmonogramAdaptacyjny nowy(*this);
+    nowy.czynnik = odczyt.f64();
+    nowy.kroki_w_oknie = odczyt.i64();
+    nowy.zaakceptowane_w_oknie = odczyt.i64();
+    return [this, nowy] { *this = nowy; };
+}
+
+HarmonogramZPodgrzewaniem::HarmonogramZPodgrzewaniem(double alpha, double T_inf, long long cierpliwosc,
+                                                     double ulamek_T0, int maks_podgrzan)
+    : alpha(alpha), T_inf(T_inf), ulamek_T0(ulamek_T0), cierpliwosc(cierpliwosc), maks_podgrzan(maks_podgrzan),
+      T_startowa(0.0), najlepsza(std::numeric_limits<int>::max()), bez_poprawy(0), podgrzania(0)
+{
+}
+
+void HarmonogramZPodgrzewaniem::rozpocznij(double T0) {
+    T_startowa = T0;
+    najlepsza = std::numeric_limits<int>::max();
+    bez_poprawy = 0;
+    podgrzania = 0;
+}
+
+double HarmonogramZPodgrzewaniem::nastepna(double T, const KrokWyzarzania& krok) {
+    if (krok.energia < najlepsza) {
+        najlepsza = krok.energia;
+        bez_poprawy = 0;
+    } else if (++bez_poprawy >= cierpliwosc && podgrzania < maks_podgrzan) {
+        ++podgrzania;
+        bez_poprawy = 0;
+        return std::max(ulamek_T0 * T_startowa, T_inf);
+    }
+    return std::max(alpha * T, T_inf);
+}
+
+void HarmonogramZPodgrzewaniem::zapisz_stan(ZapisBinarny& zapis) const {
+    zapis.f64(T_startowa);
+    zapis.i32(najlepsza);
+    zapis.i64(bez_poprawy);
+    zapis.i32(podgrzania);
+}
+
+std::function<void()> HarmonogramZPodgrzewaniem::odczytaj_stan(OdczytBinarny& odczyt) {
+    HarmonogramZPodgrzewaniem nowy(*this);
+    nowy.T_startowa = odczyt.f64();
+    nowy.najlepsza = odczyt.i32();
+    nowy.bez_poprawy = odczyt.i64();
+    nowy.podgrzania = odczyt.i32();
+    return [this, nowy] { *this = nowy; };
+}
+
+DetektorZbieznosci::DetektorZbieznosci(const UstawieniaZbieznosci& ustawienia)
+    : ustawienia(ustawienia)
+{
+    rozpocznij();
+}
+
+void DetektorZbieznosci::rozpocznij() {
+    restarty = 0;
+    rozpocznij_odcinek();
+}
+
+void DetektorZbieznosci::rozpocznij_odcinek() {
+    najlepsza = std::numeric_limits<int>::max();
+    bez_poprawy = 0;
+    kroki_w_oknie = zaakceptowane_w_oknie = 0;
+    akceptacja = 1.0;  // brak pełnego okna - nie uznajemy łańcucha za zamarznięty
+}
+
+DetektorZbieznosci::Decyzja DetektorZbieznosci::obserwuj(const KrokWyzarzania& krok) {
+    if (krok.energia < najlepsza) {
+        najlepsza = krok.energia;
+        bez_poprawy = 0;
+    } else {
+        ++bez_poprawy;
+    }
+    zaakceptowane_w_oknie += krok.zaakceptowano && krok.zmiana_energii != 0;
+    if (++kroki_w_oknie >= ustawienia.okno_akceptacji) {
+        akceptacja = static_cast<double>(zaakceptowane_w_oknie) / kroki_w_oknie;
+        kroki_w_oknie = zaakceptowane_w_oknie = 0;
+    }
+
+    if (bez_poprawy < ustawienia.okno_plateau || akceptacja >= ustawienia.prog_akceptacji) {
+        return Decyzja::Kontynuuj;
+    }
+    if (restarty < ustawienia.maks_restartow) {
+        ++restarty;
+        rozpocznij_odcinek();
+        return Decyzja::Restart;
+    }
+    return Decyzja::Zakoncz;
+}
+
+void DetektorZbieznosci::zapisz_stan(ZapisBinarny& zapis) const {
+    zapis.i32(najlepsza);
+    zapis.i64(bez_poprawy);
+    zapis.i64(kroki_w_oknie);
+    zapis.i64(zaakceptowane_w_oknie);
+    zapis.f64(akceptacja);
+    zapis.i32(restarty);
+}
+
+std::function<void()> DetektorZbieznosci::odczytaj_stan(OdczytBinarny& odczyt) {
+    DetektorZbieznosci nowy(*this);
+    nowy.najlepsza = odczyt.i32();
+    nowy.bez_poprawy = odczyt.i64();
+    nowy.kroki_w_oknie = odczyt.i64();
+    nowy.zaakceptowane_w_oknie = odczyt.i64();
+    nowy.akceptacja = odczyt.f64();
+    nowy.restarty = odczyt.i32();
+    return [this, nowy] { *this = nowy; };
+}
@@ -0,0 +1,67 @@
+#include "KluczKonformacji.h"
+
+namespace {
+    // Łańcuchy do tej długości mają klucz dokładny (3 * (N - 2) <= 128 bitów)
+    constexpr size_t MAKS_DOKLADNY = 44;
+
+    uint64_t mieszaj(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    unsigned kod_wiazania(const Vec3& d) {
+        if (d.x != 0) return d.x > 0 ? 0 : 1;
+        if (d.y != 0) return d.y > 0 ? 2 : 3;
+        return d.z > 0 ? 4 : 5;
+    }
+}
+
+KluczKonformacji klucz_konformacji(const std::vector<Vec3>& pozycje) {
+    // Przypisanie osi kanonicznych w kolejności pierwszego wystąpienia
+    int os_kanoniczna[3] = {-1, -1, -1};
+    unsigned odwrocenie[3] = {0, 0, 0};
+    int nastepna_os = 0;
+
+    const size_t n = pozycje.size();
+    const bool dokladny = n <= MAKS_DOKLADNY;
+    KluczKonformacji klucz{0, 0};
+    uint64_t slowo = 0;      // kody bieżącego fragmentu (skrót)
+    int w_slowie = 0;
+    size_t bit = 0;
+
+    for (size_t i = 0; i + 1 < n; ++i) {
+        const unsigned kod = kod_wiazania(pozycje[i + 1] - pozycje[i]);
+        const unsigned os = kod / 2;
+        if (os_kanoniczna[os] < 0) {
+            os_kanoniczna[os] = nastepna_os++;
+            odwrocenie[os] = kod % 2;
+        }
+        const uint64_t kanoniczny = 2u * os_kanoniczna[os] + ((kod % 2) ^ odwrocenie[os]);
+        if (i == 0) continue;  // pierwsze wiązanie to zawsze +x
+
+        if (dokladny) {
+            if (bit < 64) {
+                klucz.a |= kanoniczny << bit;
+                if (bit > 61) klucz.b |= kanoniczny >> (64 - bit);
+            } else {
+                klucz.b |= kanoniczny << (bit - 64);
+            }
+            bit += 3;
+        } else {
+            slowo = (slowo << 3) | kanoniczny;
+            if (++w_slowie == 21) {
+                klucz.a = mieszaj(klucz.a ^ slowo);
+                klucz.b = mieszaj(klucz.b + slowo * 0xC2B2AE3D27D4EB4FULL);
+                slowo = 0;
+                w_slowie = 0;
+            }
+        }
+    }
+    if (!dokladny) {
+        // Ostatni niepełny fragment i długość łańcucha
+        klucz.a = mieszaj(klucz.a ^ slowo ^ (static_cast<uint64_t>(n) << 63));
+        klucz.b = mieszaj(klucz.b + slowo * 0xC2B2AE3D27D4EB4FULL + n);
+    }
+    return klucz;
+}
@@ -0,0 +1,188 @@
+#include "PERM.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+namespace {
+    const double MINUS_NIESKONCZONOSC = -std::numeric_limits<double>::infinity();
+
+    /**
+     * log(exp(a) + exp(b)) bez przepełnienia.
+     */
+    double log_suma(double a, double b) {
+        if (a < b) std::swap(a, b);
+        if (b == MINUS_NIESKONCZONOSC) return a;
+        return a + std::log1p(std::exp(b - a));
+    }
+}
+
+PERM::PERM(const std::string& sekwencja, const UstawieniaPERM& ustawienia)
+    : sekwencja(sekwencja), ustawienia(ustawienia), gen(ustawienia.ziarno),
+      najlepsza_energia(0), tury(0), wezly(0), pelne(0), maks_stos(0), czas(0.0)
+{
+}
+
+void PERM::dodaj_wage(int dlugosc, double log_waga) {
+    log_suma_wag[dlugosc] = log_suma(log_suma_wag[dlugosc], log_waga);
+    liczba_lancuchow[dlugosc] += 1.0;
+}
+
+/**
+ * Skraca bieżący łańcuch do `dlugosc` aminokwasów.
+ */
+void PERM::cofnij_do(int dlugosc) {
+    while (static_cast<int>(lancuch.size()) > dlugosc) {
+        siatka.usun(lancuch.back());
+        lancuch.pop_back();
+    }
+}
+
+/**
+ * Rozwija bieżący łańcuch o jeden aminokwas: wyznacza kandydatów,
+ * decyduje o przycięciu lub wzbogaceniu i odkłada wybrane gałęzie na stos.
+ */
+void PERM::rozwin(int energia, double log_waga) {
+    const int n = static_cast<int>(lancuch.size());
+    const bool h = sekwencja[n] == 'H';
+    const double beta = 1.0 / ustawienia.T;
+
+    Kandydat kandydaci[6];
+    int liczba = 0;
+    double suma_q = 0.0;
+    for (const auto& dir : KIERUNKI) {
+        const Vec3 p = lancuch.back() + dir;
+        if (!siatka.wolne(p)) continue;
+
+        int kontakty = 0, wolni = 0;
+        for (const auto& d : KIERUNKI) {
+            int32_t k = siatka.komorka(p + d);
+            if (k == SiatkaZajetosci::PUSTA) {
+                ++wolni;
+            } else if (h && SiatkaZajetosci::hydrofobowy(k) &&
+                       SiatkaZajetosci::indeks_aminokwasu(k) != n - 1) {
+                ++kontakty;
+            }
+        }
+        const double q = (wolni + 0.5) * czynnik_boltzmanna[kontakty];
+        kandydaci[liczba++] = {p, -kontakty, q};
+        suma_q += q;
+    }
+    if (liczba == 0) return;  // ślepa uliczka
+
+    // Przewidywana waga i liczba kontynuacji k
+    double log_przewidywana = log_waga + std::log(suma_q);
+    int k = 1;
+    if (log_suma_wag[n + 1] != MINUS_NIESKONCZONOSC) {
+        // W+ = C * Z_n * (c_n / c_0)^2: przy wielu łańcuchach danej długości wzbogacamy rzadziej
+        const double log_tury = std::log(static_cast<double>(tury));
+        const double log_Z = log_suma_wag[n + 1] - log_tury;
+        const double log_W_plus = std::log(ustawienia.C) + log_Z +
+            2.0 * (std::log(liczba_lancuchow[n + 1]) - log_tury);
+        const double log_W_minus = std::log(ustawienia.prog_przycinania) + log_W_plus;
+        if (log_przewidywana > log_W_plus) {
+            const double krotnosc = std::exp(std::min(log_przewidywana - log_W_plus, 10.0));
+            k = std::min(liczba, static_cast<int>(std::ceil(krotnosc)));
+            // Limit populacji: bez wzbogacania, gdy stos jest pełny
+            const size_t wolne_miejsca = ustawienia.maks_populacja > stos.size()
+                ? ustawienia.maks_populacja - stos.size() : 0;
+            k = static_cast<int>(std::max<size_t>(1, std::min<size_t>(k, wolne_miejsca)));
+        } else if (log_przewidywana < log_W_minus) {
+            if (gen.ponizej(2) == 0) return;  // przycięcie
+            log_przewidywana += std::log(2.0);
+        }
+    }
+
+    // k różnych kandydatów losowanych proporcjonalnie do q (bez powtórzeń)
+    double pozostala_suma = suma_q;
+    for (int wybrane = 0; wybrane < k; ++wybrane) {
+        double r = gen.jednostajna() * pozostala_suma;
+        int a = wybrane;
+        for (; a < liczba - 1; ++a) {
+            r -= kandydaci[a].q;
+            if (r < 0.0) break;
+        }
+        std::swap(kandydaci[wybrane], kandydaci[a]);
+        const Kandydat& c = kandydaci[wybrane];
+        pozostala_suma -= c.q;
+
+        // W_n = W_{n-1} * exp(-βΔE) * Σq / (k q)
+        const double log_nowa = log_przewidywana - beta * c.dE - std::log(k * c.q);
+        dodaj_wage(n + 1, log_nowa);
+        stos.push_back({n + 1, c.pozycja, log_nowa, energia + c.dE});
+    }
+    maks_stos = std::max(maks_stos, stos.size());
+}
+
+bool PERM::uruchom() {
+    const int N = static_cast<int>(sekwencja.size());
+    const auto start = std::chrono::steady_clock::now();
+    log_suma_wag.assign(N + 1, MINUS_NIESKONCZONOSC);
+    liczba_lancuchow.assign(N + 1, 0.0);
+    najlepsza_energia = std::numeric_limits<int>::max();
+    najlepsza_konformacja.clear();
+    tury = wezly = pelne = 0;
+    maks_stos = 0;
+    lancuch.reserve(N);
+    for (int k = 0; k < 7; ++k) czynnik_boltzmanna[k] = std::exp(k / ustawienia.T);
+    stos.reserve(std::min<size_t>(ustawienia.maks_populacja, 1 << 16));
+
+    bool cel = false;
+    while (!cel && N > 0 && tury < ustawienia.maks_tur && wezly < ustawienia.maks_wezlow) {
+        ++tury;
+
+        // Każda tura zaczyna od pierwszego aminokwasu w początku układu
+        cofnij_do(0);
+        lancuch.push_back(Vec3{0, 0, 0});
+        siatka.wstaw(lancuch.back(), 0, sekwencja[0]);
+        dodaj_wage(1, 0.0);
+        stos.push_back({1, lancuch.back(), 0.0, 0});
+        bool pierwszy = true;
+
+        while (!stos.empty() && !cel) {
+            Galaz g = stos.back();
+            stos.pop_back();
+            if (pierwszy) {
+                pierwszy = false;
+            } else {
+                cofnij_do(g.dlugosc - 1);
+                lancuch.push_back(g.pozycja);
+                siatka.wstaw(g.pozycja, g.dlugosc - 1, sekwencja[g.dlugosc - 1]);
+                ++wezly;
+            }
+
+            if (g.dlugosc == N) {
+                ++pelne;
+                if (g.energia < najlepsza_energia) {
+                    najlepsza_energia = g.energia;
+                    najlepsza_konformacja = lancuch;
+                    cel = ustawienia.energia_docelowa != 0 && g.energia <= ustawienia.energia_docelowa;
+                }
+                continue;
+            }
+            rozwin(g.energia, g.log_waga);
+        }
+        stos.clear();
+    }
+    cofnij_do(0);
+
+    if (najlepsza_konformacja.empty()) najlepsza_energia = 0;
+    czas = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return !najlepsza_konformacja.empty();
+}
+
+bool PERM::zapisz_konformacje(const std::string& sciezka) const {
+    std::ofstream plik(sciezka);
+    if (!plik) return false;
+    for (const auto& poz : najlepsza_konformacja) {
+        plik << poz.x << " " << poz.y << " " << poz.z << "\n";
+    }
+    return static_cast<bool>(plik);
+}
+
+void PERM::wypisz_statystyki(std::ostream& out) const {
+    out << "PERM: tury " << tury << ", dołożone aminokwasy " << wezly
+        << ", pełne łańcuchy " << pelne << ", maks. populacja " << maks_stos << "\n";
+    out << "Najlepsza energia: " << najlepsza_energia << ", czas: " << czas << " s\n";
+}
@@ -0,0 +1,186 @@
+#include "PamiecKonformacji.h"
+#include <algorithm>
+#include <limits>
+
+PamiecKonformacji::PamiecKonformacji(size_t pojemnosc, size_t liczba_segmentow) {
+    liczba_segmentow = std::max<size_t>(1, liczba_segmentow);
+    const size_t koszyki = (std::max<size_t>(1, pojemnosc) + ZBIEZNOSC - 1) / ZBIEZNOSC;
+    koszyki_w_segmencie = std::max<size_t>(1, (koszyki + liczba_segmentow - 1) / liczba_segmentow);
+
+    segmenty.reserve(liczba_segmentow);
+    for (size_t s = 0; s < liczba_segmentow; ++s) {
+        segmenty.push_back(std::make_unique<Segment>());
+        segmenty.back()->miejsca.assign(koszyki_w_segmencie * ZBIEZNOSC, Miejsce{{0, 0}, {0, 0, 0}, false});
+    }
+}
+
+// Segment z górnej, koszyk z dolnej połowy skrótu, żeby były od siebie niezależne
+PamiecKonformacji::Segment& PamiecKonformacji::znajdz_koszyk(const KluczKonformacji& klucz, size_t& poczatek) const {
+    const uint64_t skrot = std::hash<KluczKonformacji>()(klucz);
+    poczatek = static_cast<size_t>((skrot & 0xFFFFFFFFULL) % koszyki_w_segmencie) * ZBIEZNOSC;
+    return *segmenty[static_cast<size_t>(skrot >> 32) % segmenty.size()];
+}
+
+WpisKonformacji PamiecKonformacji::odwiedz(const KluczKonformacji& klucz, int energia, long long krok) {
+    size_t poczatek;
+    Segment& seg = znajdz_koszyk(klucz, poczatek);
+    Miejsce* koszyk = &seg.miejsca[poczatek];
+
+    std::lock_guard<std::mutex> blokada(seg.mutex);
+    Miejsce* wolne = nullptr;
+    Miejsce* ofiara = nullptr;
+    for (size_t k = 0; k < ZBIEZNOSC; ++k) {
+        Miejsce& m = koszyk[k];
+        if (!m.zajete) {
+            if (!wolne) wolne = &m;
+            continue;
+        }
+        if (m.klucz == klucz) {
+            if (m.wpis.odwiedziny < std::numeric_limits<uint32_t>::max()) ++m.wpis.odwiedziny;
+            return m.wpis;
+        }
+        if (!ofiara || m.wpis.energia > ofiara->wpis.energia ||
+            (m.wpis.energia == ofiara->wpis.energia && m.wpis.odwiedziny < ofiara->wpis.odwiedziny)) {
+            ofiara = &m;
+        }
+    }
+
+    Miejsce* cel = wolne;
+    if (!cel) {
+        // Nowa konformacja o wyższej energii niż wszystkie w koszyku nie wypiera żadnej
+        if (energia > ofiara->wpis.energia) return WpisKonformacji{energia, 1, krok};
+        cel = ofiara;
+        ++seg.wyparcia;
+    } else {
+        ++seg.zajete;
+    }
+    cel->klucz = klucz;
+    cel->wpis = WpisKonformacji{energia, 1, krok};
+    cel->zajete = true;
+    return cel->wpis;
+}
+
+bool PamiecKonformacji::znajdz(const KluczKonformacji& klucz, WpisKonformacji& wpis) const {
+    size_t poczatek;
+    const Segment& seg = znajdz_koszyk(klucz, poczatek);
+    const Miejsce* koszyk = &seg.miejsca[poczatek];
+
+    std::lock_guard<std::mutex> blokada(seg.mutex);
+    for (size_t k = 0; k < ZBIEZNOSC; ++k) {
+        if (koszyk[k].zajete && koszyk[k].klucz == klucz) {
+            wpis = koszyk[k].wpis;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t PamiecKonformacji::zlicz_konformacje(int energia_maks) const {
+    size_t liczba = 0;
+    for (const auto& seg : segmenty) {
+        std::lock_guard<std::mutex> blokada(seg->mutex);
+        for (const Miejsce& m : seg->miejsca) {
+            if (m.zajete && m.wpis.energia <= energia_maks) ++liczba;
+        }
+    }
+    return liczba;
+}
+
+int PamiecKonformacji::najnizsza_energia() const {
+    int najnizsza = std::numeric_limits<int>::max();
+    for (const auto& seg : segmenty) {
+        std::lock_guard<std::mutex> blokada(seg->mutex);
+        for (const Miejsce& m : seg->miejsca) {
+            if (m.zajete) najnizsza = std::min(najnizsza, m.wpis.energia);
+        }
+    }
+    return najnizsza == std::numeric_limits<int>::max() ? 0 : najnizsza;
+}
+
+size_t PamiecKonformacji::rozmiar() const {
+    size_t suma = 0;
+    for (const auto& seg : segmenty) {
+        std::lock_guard<std::mutex> blokada(seg->mutex);
+        suma += seg->zajete;
+    }
+    return suma;
+}
+
+uint64_t PamiecKonformacji::get_wyparcia() const {
+    uint64_t suma = 0;
+    for (const auto& seg : segmenty) {
+        std::lock_guard<std::mutex> blokada(seg->mutex);
+        suma += seg->wyparcia;
+    }
+    return suma;
+}
+
+void PamiecKonformacji::wyczysc() {
+    for (const auto& seg : segmenty) {
+        std::lock_guard<std::mutex> blokada(seg->mutex);
+        for (Miejsce& m : seg->miejsca) m.zajete = false;
+        seg->zajete = 0;
+        seg->wyparcia = 0;
+    }
+}
+
+void PamiecKonformacji::zapisz_stan(ZapisBinarny& zapis) const {
+    zapis.u32(static_cast<uint32_t>(segmenty.size()));
+    zapis.u64(koszyki_w_segmencie);
+    for (const auto& seg : segmenty) {
+        std::lock_guard<std::mutex> blokada(seg->mutex);
+        zapis.u64(seg->zajete);
+        zapis.u64(seg->wyparcia);
+        for (size_t m = 0; m < seg->miejsca.size(); ++m) {
+            const Miejsce& miejsce = seg->miejsca[m];
+            if (!miejsce.zajete) continue;
+            zapis.u32(static_cast<uint32_t>(m));
+            zapis.u64(miejsce.klucz.a);
+            zapis.u64(miejsce.klucz.b);
+            zapis.i32(miejsce.wpis.energia);
+            zapis.u32(miejsce.wpis.odwiedziny);
+            zapis.i64(miejsce.wpis.pierwszy_krok);
+        }
+    }
+}
+
+std::function<void()> PamiecKonformacji::odczytaj_stan(OdczytBinarny& odczyt) {
+    if (odczyt.u32() != segmenty.size() || odczyt.u64() != koszyki_w_segmencie) return nullptr;
+
+    // Wpisy trafiają najpierw do kopii; pamięć zmienia dopiero zwrócona funkcja
+    struct Wpis {
+        uint32_t segment, miejsce;
+        Miejsce dane;
+    };
+    auto wpisy = std::make_shared<std::vector<Wpis>>();
+    auto liczniki = std::make_shared<std::vector<std::pair<uint64_t, uint64_t>>>(segmenty.size());
+    const size_t miejsca = koszyki_w_segmencie * ZBIEZNOSC;
+    for (size_t s = 0; s < segmenty.size(); ++s) {
+        const uint64_t zajete = odczyt.u64();
+        (*liczniki)[s] = {zajete, odczyt.u64()};
+        if (!odczyt.ok() || zajete > miejsca) return nullptr;
+        for (uint64_t k = 0; k < zajete; ++k) {
+            Wpis w{static_cast<uint32_t>(s), odczyt.u32(), {{0, 0}, {0, 0, 0}, true}};
+            w.dane.klucz.a = odczyt.u64();
+            w.dane.klucz.b = odczyt.u64();
+            w.dane.wpis.energia = odczyt.i32();
+            w.dane.wpis.odwiedziny = odczyt.u32();
+            w.dane.wpis.pierwszy_krok = odczyt.i64();
+            if (!odczyt.ok() || w.miejsce >= miejsca) return nullptr;
+            wpisy->push_back(w);
+        }
+    }
+    return [this, wpisy, liczniki] {
+        wyczysc();
+        for (size_t s = 0; s < segmenty.size(); ++s) {
+            std::lock_guard<std::mutex> blokada(segmenty[s]->mutex);
+            segmenty[s]->zajete = (*liczniki)[s].first;
+            segmenty[s]->wyparcia = (*liczniki)[s].second;
+        }
+        for (const Wpis& w : *wpisy) {
+            Segment& seg = *segmenty[w.segment];
+            std::lock_guard<std::mutex> blokada(seg.mutex);
+            seg.miejsca[w.miejsce] = w.dane;
+        }
+    };
+}
@@ -0,0 +1,137 @@
+#include "Przeglad.h"
+#include "HP_model.h"
+#include "PulaWatkow.h"
+#include <cmath>
+#include <filesystem>
+#include <memory>
+
+uint64_t ziarno_przebiegu(uint64_t ziarno_bazowe, uint64_t numer) {
+    uint64_t z = ziarno_bazowe + (numer + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+namespace {
+    /**
+     * Pojedynczy przebieg przeglądu we własnym katalogu wyjściowym.
+     */
+    void uruchom_przebieg(WynikPrzebiegu& wynik, const UstawieniaZbieznosci* zbieznosc) {
+        std::filesystem::create_directories(wynik.katalog);
+
+        HP_model model;
+        model.ustaw_ziarno(wynik.ziarno);
+        model.ustaw_gadatliwosc(Gadatliwosc::Cisza);
+        model.ustaw_katalog_wyjsciowy(wynik.katalog);
+        model.ustaw_zapis_energii(false);
+        model.ustaw_statystyki(&wynik.statystyki);
+
+        // Próbujemy wygenerować początkową konformację
+        const int max_proby = 1000;
+        bool sukces = false;
+        for (int proby = 0; !sukces && proby < max_proby; ++proby) {
+            sukces = model.generuj_startowa_konformacje(wynik.params.losowa_init);
+        }
+        wynik.sukces = sukces;
+        if (!sukces) return;
+
+        std::unique_ptr<DetektorZbieznosci> detektor;
+        if (zbieznosc) {
+            detektor = std::make_unique<DetektorZbieznosci>(*zbieznosc);
+            model.ustaw_detektor_zbieznosci(detektor.get());
+        }
+
+        const ParametrSymulacji& p = wynik.params;
+        model.algorytm_metropolisa(p.T0, p.T_inf, p.alpha, p.kroki);
+
+        wynik.energia = model.get_energia();
+        wynik.akceptowane_koniec = model.get_zaakceptowane_koniec();
+        wynik.akceptowane_naroznik = model.get_zaakceptowane_naroznik();
+        wynik.akceptowane_crankshaft = model.get_zaakceptowane_crankshaft();
+        wynik.akceptowane_pull = model.get_zaakceptowane_pull();
+        wynik.wykonane_kroki = model.get_kroki_przebiegu();
+    }
+}
+
+std::vector<WynikPrzebiegu> przeprowadz_przeglad(const std::vector<ParametrSymulacji>& siatka,
+                                                 int powtorzenia, uint64_t ziarno_bazowe,
+                                                 const std::string& katalog_bazowy,
+                                                 size_t watki,
+                                                 const UstawieniaZbieznosci* zbieznosc) {
+    namespace fs = std::filesystem;
+
+    // Wyniki przydzielone z góry: każde zadanie pisze tylko do swojego elementu
+    std::vector<WynikPrzebiegu> wyniki;
+    for (size_t i = 0; i < siatka.size(); ++i) {
+        for (int r = 0; r < powtorzenia; ++r) {
+            uint64_t numer = wyniki.size();
+            std::string katalog = (fs::path(katalog_bazowy) / ("przebieg_" + std::to_string(numer))).string();
+            wyniki.push_back({siatka[i], r, ziarno_przebiegu(ziarno_bazowe, numer), katalog,
+                              false, 0.0, 0, 0, 0, 0, 0, StatystykiPrzebiegu()});
+        }
+    }
+
+    PulaWatkow pula(watki);
+    for (auto& wynik : wyniki) {
+        pula.dodaj([&wynik, zbieznosc] { uruchom_przebieg(wynik, zbieznosc); });
+    }
+    pula.czekaj();
+    return wyniki;
+}
+
+void zapisz_wyniki_csv(const std::vector<WynikPrzebiegu>& wyniki, std::ostream& out) {
+    out << "Inicjalizacja,T0,T_inf,alpha,Kroki,Energia,Akc_end,Akc_corner,Akc_crankshaft,Akc_pull,Powtorzenie,Ziarno,Wykonane_kroki,"
+           "Srednia_E,Odch_E,Tau,E_najlepsza,Krok_najlepszej\n";
+    for (const auto& w : wyniki) {
+        if (!w.sukces) continue;
+        out << (w.params.losowa_init ? "losowa" : "liniowa") << ","
+            << w.params.T0 << ","
+            << w.params.T_inf << ","
+            << w.params.alpha << ","
+            << w.params.kroki << ","
+            << w.energia << ","
+            << w.akceptowane_koniec << ","
+            << w.akceptowane_naroznik << ","
+            << w.akceptowane_crankshaft << ","
+            << w.akceptowane_pull << ","
+            << w.powtorzenie << ","
+            << w.ziarno << ","
+            << w.wykonane_kroki << ","
+            << w.statystyki.get_srednia() << ","
+            << std::sqrt(w.statystyki.get_wariancja()) << ","
+            << w.statystyki.get_czas_autokorelacji() << ","
+            << w.statystyki.get_najlepsza_energia() << ","
+            << w.statystyki.get_krok_najlepszej() << "\n";
+    }
+}
+
+void zapisz_statystyki_csv(const std::vector<WynikPrzebiegu>& wyniki, std::ostream& out) {
+    out << "Inicjalizacja,T0,T_inf,alpha,Kroki,Przebiegi,Kroki_lacznie,Srednia_E,Blad_sredniej,Tau,E_najlepsza\n";
+    size_t i = 0;
+    while (i < wyniki.size()) {
+        // Powtórzenia jednego zestawu parametrów leżą obok siebie, od powtórzenia 0
+        const ParametrSymulacji& p = wyniki[i].params;
+        StatystykiPrzebiegu scalone;
+        int przebiegi = 0;
+        do {
+            if (wyniki[i].sukces) {
+                scalone.scal(wyniki[i].statystyki);
+                ++przebiegi;
+            }
+            ++i;
+        } while (i < wyniki.size() && wyniki[i].powtorzenie != 0);
+        if (przebiegi == 0) continue;
+
+        out << (p.losowa_init ? "losowa" : "liniowa") << ","
+            << p.T0 << ","
+            << p.T_inf << ","
+            << p.alpha << ","
+            << p.kroki << ","
+            << przebiegi << ","
+            << scalone.get_liczba() << ","
+            << scalone.get_srednia() << ","
+            << scalone.get_blad_sredniej() << ","
+            << scalone.get_czas_autokorelacji() << ","
+            << scalone.get_najlepsza_energia() << "\n";
+    }
+}
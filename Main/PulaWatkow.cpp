@@ -0,0 +1,114 @@
+#include "PulaWatkow.h"
+
+namespace {
+    // Pula i indeks wątku wykonującego bieżące zadanie (nullptr poza pulą)
+    thread_local const PulaWatkow* biezaca_pula = nullptr;
+    thread_local size_t biezacy_watek = 0;
+}
+
+/**
+ * Konstruktor: uruchamia wątki robocze, każdy z własną kolejką.
+ */
+PulaWatkow::PulaWatkow(size_t liczba_watkow)
+    : w_kolejkach(0), niezakonczone(0), nastepna(0), koniec(false)
+{
+    if (liczba_watkow == 0) liczba_watkow = std::thread::hardware_concurrency();
+    if (liczba_watkow == 0) liczba_watkow = 1;
+
+    for (size_t i = 0; i < liczba_watkow; ++i) {
+        kolejki.push_back(std::make_unique<Kolejka>());
+    }
+    for (size_t i = 0; i < liczba_watkow; ++i) {
+        watki.emplace_back(&PulaWatkow::petla, this, i);
+    }
+}
+
+PulaWatkow::~PulaWatkow() {
+    {
+        std::lock_guard<std::mutex> blokada(mutex_stanu);
+        koniec = true;
+    }
+    sygnal_pracy.notify_all();
+    for (auto& watek : watki) watek.join();
+}
+
+void PulaWatkow::dodaj(std::function<void()> zadanie) {
+    size_t id;
+    {
+        // Liczniki rosną przed wstawieniem, więc nigdy nie spadają poniżej zera
+        std::lock_guard<std::mutex> blokada(mutex_stanu);
+        id = biezaca_pula == this ? biezacy_watek : nastepna++ % kolejki.size();
+        ++w_kolejkach;
+        ++niezakonczone;
+    }
+    {
+        std::lock_guard<std::mutex> blokada(kolejki[id]->mutex);
+        kolejki[id]->zadania.push_back(std::move(zadanie));
+    }
+    sygnal_pracy.notify_one();
+}
+
+void PulaWatkow::czekaj() {
+    std::unique_lock<std::mutex> blokada(mutex_stanu);
+    sygnal_gotowe.wait(blokada, [this] { return niezakonczone == 0; });
+    if (blad) {
+        std::exception_ptr e = blad;
+        blad = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+/**
+ * Pobiera zadanie: najpierw z końca własnej kolejki, potem z początku cudzych.
+ */
+bool PulaWatkow::wez(size_t id, std::function<void()>& zadanie) {
+    {
+        Kolejka& wlasna = *kolejki[id];
+        std::lock_guard<std::mutex> blokada(wlasna.mutex);
+        if (!wlasna.zadania.empty()) {
+            zadanie = std::move(wlasna.zadania.back());
+            wlasna.zadania.pop_back();
+            return true;
+        }
+    }
+    for (size_t k = 1; k < kolejki.size(); ++k) {
+        Kolejka& obca = *kolejki[(id + k) % kolejki.size()];
+        std::lock_guard<std::mutex> blokada(obca.mutex);
+        if (!obca.zadania.empty()) {
+            zadanie = std::move(obca.zadania.front());
+            obca.zadania.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void PulaWatkow::petla(size_t id) {
+    biezaca_pula = this;
+    biezacy_watek = id;
+
+    std::function<void()> zadanie;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> blokada(mutex_stanu);
+            sygnal_pracy.wait(blokada, [this] { return w_kolejkach > 0 || koniec; });
+            if (w_kolejkach == 0 && koniec) return;
+        }
+        if (!wez(id, zadanie)) continue;
+        {
+            std::lock_guard<std::mutex> blokada(mutex_stanu);
+            --w_kolejkach;
+        }
+
+        try {
+            zadanie();
+        } catch (...) {
+            std::lock_guard<std::mutex> blokada(mutex_stanu);
+            if (!blad) blad = std::current_exception();
+        }
+        zadanie = nullptr;
+
+        std::lock_guard<std::mutex> blokada(mutex_stanu);
+        if (--niezakonczone == 0) sygnal_gotowe.notify_all();
+    }
+}
@@ -0,0 +1,158 @@
+#include "PunktKontrolny.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    uint64_t fnv1a(const uint8_t* p, size_t n) {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (size_t i = 0; i < n; ++i) {
+            h ^= p[i];
+            h *= 0x100000001b3ULL;
+        }
+        return h;
+    }
+
+#ifndef _WIN32
+    bool zapisz_wszystko(int fd, const uint8_t* p, size_t n) {
+        while (n > 0) {
+            const ssize_t zapisane = ::write(fd, p, n);
+            if (zapisane < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            p += zapisane;
+            n -= static_cast<size_t>(zapisane);
+        }
+        return true;
+    }
+#endif
+}
+
+bool punkt_kontrolny::zapisz_atomowo(const std::string& sciezka, const std::vector<uint8_t>& dane) {
+    const std::string tymczasowy = sciezka + ".tmp";
+#ifdef _WIN32
+    {
+        std::ofstream plik(tymczasowy, std::ios::binary | std::ios::trunc);
+        if (!plik) return false;
+        plik.write(reinterpret_cast<const char*>(dane.data()), static_cast<std::streamsize>(dane.size()));
+        plik.flush();
+        if (!plik) return false;
+    }
+    std::error_code blad;
+    std::filesystem::rename(tymczasowy, sciezka, blad);
+    return !blad;
+#else
+    // Dane pliku tymczasowego muszą trafić na dysk przed rename, inaczej po awarii
+    // zasilania pod docelową nazwą może zostać plik pusty lub obcięty.
+    const int fd = ::open(tymczasowy.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    bool ok = zapisz_wszystko(fd, dane.data(), dane.size()) && ::fsync(fd) == 0;
+    ok = (::close(fd) == 0) && ok;
+    if (!ok || ::rename(tymczasowy.c_str(), sciezka.c_str()) != 0) {
+        ::unlink(tymczasowy.c_str());
+        return false;
+    }
+
+    // Sama zmiana nazwy jest trwała dopiero po fsync katalogu nadrzędnego
+    std::string katalog = std::filesystem::path(sciezka).parent_path().string();
+    if (katalog.empty()) katalog = ".";
+    const int fd_katalogu = ::open(katalog.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd_katalogu < 0) return false;
+    ok = ::fsync(fd_katalogu) == 0;
+    ::close(fd_katalogu);
+    return ok;
+#endif
+}
+
+ZapisBinarny::ZapisBinarny() {
+    dane.assign(punkt_kontrolny::MAGIA, punkt_kontrolny::MAGIA + 4);
+    u32(punkt_kontrolny::WERSJA);
+}
+
+void ZapisBinarny::u32(uint32_t v) {
+    for (int b = 0; b < 4; ++b) dane.push_back(static_cast<uint8_t>(v >> (8 * b)));
+}
+
+void ZapisBinarny::u64(uint64_t v) {
+    for (int b = 0; b < 8; ++b) dane.push_back(static_cast<uint8_t>(v >> (8 * b)));
+}
+
+void ZapisBinarny::f64(double v) {
+    uint64_t bity;
+    std::memcpy(&bity, &v, sizeof(bity));
+    u64(bity);
+}
+
+void ZapisBinarny::tekst(const std::string& s) {
+    u32(static_cast<uint32_t>(s.size()));
+    dane.insert(dane.end(), s.begin(), s.end());
+}
+
+const std::vector<uint8_t>& ZapisBinarny::zakoncz() {
+    u64(fnv1a(dane.data(), dane.size()));
+    return dane;
+}
+
+bool OdczytBinarny::otworz(const std::string& sciezka) {
+    poprawny = false;
+    std::ifstream plik(sciezka, std::ios::binary);
+    if (!plik) return false;
+    dane.assign(std::istreambuf_iterator<char>(plik), std::istreambuf_iterator<char>());
+    if (dane.size() < 16 || std::memcmp(dane.data(), punkt_kontrolny::MAGIA, 4) != 0) return false;
+
+    // Suma kontrolna na końcu pliku
+    koniec = dane.size() - 8;
+    uint64_t suma = 0;
+    for (int b = 0; b < 8; ++b) suma |= static_cast<uint64_t>(dane[koniec + b]) << (8 * b);
+    if (suma != fnv1a(dane.data(), koniec)) return false;
+
+    poprawny = true;
+    pozycja = 4;
+    if (u32() != punkt_kontrolny::WERSJA) return poprawny = false;
+    return true;
+}
+
+const uint8_t* OdczytBinarny::wez(size_t n) {
+    if (!poprawny || koniec - pozycja < n) {
+        poprawny = false;
+        return nullptr;
+    }
+    const uint8_t* p = dane.data() + pozycja;
+    pozycja += n;
+    return p;
+}
+
+uint32_t OdczytBinarny::u32() {
+    const uint8_t* p = wez(4);
+    uint32_t v = 0;
+    if (p) for (int b = 0; b < 4; ++b) v |= static_cast<uint32_t>(p[b]) << (8 * b);
+    return v;
+}
+
+uint64_t OdczytBinarny::u64() {
+    const uint8_t* p = wez(8);
+    uint64_t v = 0;
+    if (p) for (int b = 0; b < 8; ++b) v |= static_cast<uint64_t>(p[b]) << (8 * b);
+    return v;
+}
+
+double OdczytBinarny::f64() {
+    const uint64_t bity = u64();
+    double v;
+    std::memcpy(&v, &bity, sizeof(v));
+    return v;
+}
+
+std::string OdczytBinarny::tekst() {
+    const uint32_t n = u32();
+    const uint8_t* p = wez(n);
+    return p ? std::string(reinterpret_cast<const char*>(p), n) : std::string();
+}
@@ -0,0 +1,133 @@
+#include "Siatka.h"
+#include <algorithm>
+
+namespace {
+    // Minimalny rozmiar siatki w każdej osi: 2^4 = 16 węzłów
+    constexpr int MIN_BITY = 4;
+
+    int rozpietosc(int a, int b) { return b - a + 1; }
+}
+
+/**
+ * Konstruktor: pusta siatka minimalnego rozmiaru.
+ */
+SiatkaZajetosci::SiatkaZajetosci() {
+    wyczysc();
+}
+
+void SiatkaZajetosci::wyczysc() {
+    const int minimalne[3] = {MIN_BITY, MIN_BITY, MIN_BITY};
+    ustaw_rozmiar(minimalne);
+    min_poz = max_poz = Vec3{0, 0, 0};
+    pusta = true;
+}
+
+void SiatkaZajetosci::zarezerwuj(size_t dlugosc) {
+    // Najmniejsza rozpiętość (max - min) w osi, przy której oś potrzebuje 2^b węzłów
+    auto minimalny_zasieg = [](int b) { return b <= MIN_BITY ? 0LL : (1LL << (b - 1)) - MARGINES; };
+    const long long zasieg = dlugosc > 0 ? static_cast<long long>(dlugosc) - 1 : 0;
+
+    int najwiecej_bitow = 3 * MIN_BITY;
+    for (int bx = MIN_BITY; minimalny_zasieg(bx) <= zasieg; ++bx) {
+        for (int by = MIN_BITY; minimalny_zasieg(bx) + minimalny_zasieg(by) <= zasieg; ++by) {
+            for (int bz = MIN_BITY; minimalny_zasieg(bx) + minimalny_zasieg(by) + minimalny_zasieg(bz) <= zasieg; ++bz) {
+                najwiecej_bitow = std::max(najwiecej_bitow, bx + by + bz);
+            }
+        }
+    }
+    if (najwiecej_bitow > MAKS_BITY_REZERWY) return;
+    komorki.reserve(size_t(1) << najwiecej_bitow);
+    zapas.reserve(size_t(1) << najwiecej_bitow);
+    zarezerwowana = true;
+}
+
+/**
+ * Przydziela (lub tylko czyści) tablicę komórek o rozmiarze 2^bity w każdej osi.
+ */
+void SiatkaZajetosci::ustaw_rozmiar(const int nowe_bity[3]) {
+    for (int os = 0; os < 3; ++os) {
+        bity[os] = nowe_bity[os];
+        maska[os] = (1 << nowe_bity[os]) - 1;
+    }
+    komorki.assign(size_t(1) << (bity[0] + bity[1] + bity[2]), PUSTA);
+}
+
+/**
+ * Powiększa siatkę tak, aby pudło [nowe_min, nowe_max] mieściło się z zapasem.
+ * Rzeczywiste współrzędne zajętych komórek odtwarzane są z bieżącego pudła,
+ * które z założenia jest mniejsze od rozmiaru siatki.
+ */
+void SiatkaZajetosci::powieksz(const Vec3& nowe_min, const Vec3& nowe_max) {
+    const int potrzebne[3] = {
+        rozpietosc(nowe_min.x, nowe_max.x) + MARGINES,
+        rozpietosc(nowe_min.y, nowe_max.y) + MARGINES,
+        rozpietosc(nowe_min.z, nowe_max.z) + MARGINES
+    };
+    int nowe_bity[3];
+    for (int os = 0; os < 3; ++os) {
+        nowe_bity[os] = std::max(bity[os], MIN_BITY);
+        while ((1 << nowe_bity[os]) < potrzebne[os]) ++nowe_bity[os];
+    }
+
+    // Stara tablica trafia do zapasu, a nowa powstaje w pojemności poprzedniego zapasu
+    zapas.swap(komorki);
+    const std::vector<int32_t>& stare = zapas;
+    const int stare_bity[3] = {bity[0], bity[1], bity[2]};
+    const int stara_maska[3] = {maska[0], maska[1], maska[2]};
+    ustaw_rozmiar(nowe_bity);
+
+    for (size_t idx = 0; idx < stare.size(); ++idx) {
+        if (stare[idx] == PUSTA) continue;
+        int wx = static_cast<int>(idx & stara_maska[0]);
+        int wy = static_cast<int>((idx >> stare_bity[0]) & stara_maska[1]);
+        int wz = static_cast<int>((idx >> (stare_bity[0] + stare_bity[1])) & stara_maska[2]);
+        Vec3 p{
+            min_poz.x + ((wx - min_poz.x) & stara_maska[0]),
+            min_poz.y + ((wy - min_poz.y) & stara_maska[1]),
+            min_poz.z + ((wz - min_poz.z) & stara_maska[2])
+        };
+        komorki[indeks_komorki(p)] = stare[idx];
+    }
+    // Bez rezerwy stara tablica jest zwalniana od razu, jak dotąd
+    if (!zarezerwowana) std::vector<int32_t>().swap(zapas);
+}
+
+void SiatkaZajetosci::wstaw(const Vec3& p, size_t indeks, char typ) {
+    if (pusta) {
+        min_poz = max_poz = p;
+        pusta = false;
+    } else {
+        Vec3 nowe_min{std::min(min_poz.x, p.x), std::min(min_poz.y, p.y), std::min(min_poz.z, p.z)};
+        Vec3 nowe_max{std::max(max_poz.x, p.x), std::max(max_poz.y, p.y), std::max(max_poz.z, p.z)};
+        if (rozpietosc(nowe_min.x, nowe_max.x) + MARGINES > maska[0] + 1 ||
+            rozpietosc(nowe_min.y, nowe_max.y) + MARGINES > maska[1] + 1 ||
+            rozpietosc(nowe_min.z, nowe_max.z) + MARGINES > maska[2] + 1) {
+            powieksz(nowe_min, nowe_max);
+        }
+        min_poz = nowe_min;
+        max_poz = nowe_max;
+    }
+    zajmij(p, indeks, typ);
+}
+
+void SiatkaZajetosci::dopasuj(const std::vector<Vec3>& pozycje) {
+    if (pozycje.empty()) return;
+
+    Vec3 nowe_min = pozycje[0], nowe_max = pozycje[0];
+    for (const auto& p : pozycje) {
+        nowe_min = Vec3{std::min(nowe_min.x, p.x), std::min(nowe_min.y, p.y), std::min(nowe_min.z, p.z)};
+        nowe_max = Vec3{std::max(nowe_max.x, p.x), std::max(nowe_max.y, p.y), std::max(nowe_max.z, p.z)};
+    }
+    dopasuj(nowe_min, nowe_max);
+}
+
+void SiatkaZajetosci::dopasuj(const Vec3& min, const Vec3& max) {
+    if (rozpietosc(min.x, max.x) + MARGINES > maska[0] + 1 ||
+        rozpietosc(min.y, max.y) + MARGINES > maska[1] + 1 ||
+        rozpietosc(min.z, max.z) + MARGINES > maska[2] + 1) {
+        powieksz(min, max);
+    }
+    min_poz = min;
+    max_poz = max;
+    pusta = false;
+}
@@ -0,0 +1,216 @@
+#include "StatystykiPrzebiegu.h"
+#include <algorithm>
+#include <memory>
+#include <cmath>
+#include <limits>
+
+StatystykiPrzebiegu::StatystykiPrzebiegu(long long okno_akceptacji)
+    : okno_akceptacji(okno_akceptacji > 0 ? okno_akceptacji : 1)
+{
+    wyczysc();
+}
+
+void StatystykiPrzebiegu::wyczysc() {
+    suma = suma_kw = 0;
+    liczba = 0;
+    histogram.clear();
+    energia_histogramu = 0;
+    najlepsza_energia = std::numeric_limits<int>::max();
+    krok_najlepszej = -1;
+    najlepsza_konformacja.clear();
+    kroki_w_oknie = 0;
+    for (int t = 0; t < LICZBA_TYPOW_RUCHU; ++t) {
+        okno_proponowane[t] = okno_zaakceptowane[t] = 0;
+        proponowane[t] = zaakceptowane[t] = 0;
+        akceptacja_okna[t] = 0.0;
+    }
+    poziomy.clear();
+}
+
+void StatystykiPrzebiegu::rozszerz_histogram(int energia, uint64_t liczba_krokow) {
+    if (histogram.empty()) {
+        histogram.assign(1, liczba_krokow);
+        energia_histogramu = energia;
+        return;
+    }
+    if (energia < energia_histogramu) {
+        histogram.insert(histogram.begin(), static_cast<size_t>(energia_histogramu - energia), 0);
+        energia_histogramu = energia;
+    } else if (energia > get_energia_max()) {
+        histogram.resize(static_cast<size_t>(energia - energia_histogramu) + 1, 0);
+    }
+    histogram[static_cast<size_t>(energia - energia_histogramu)] += liczba_krokow;
+}
+
+void StatystykiPrzebiegu::zamknij_okno() {
+    for (int t = 0; t < LICZBA_TYPOW_RUCHU; ++t) {
+        akceptacja_okna[t] = okno_proponowane[t] > 0
+            ? static_cast<double>(okno_zaakceptowane[t]) / okno_proponowane[t] : 0.0;
+        proponowane[t] += okno_proponowane[t];
+        zaakceptowane[t] += okno_zaakceptowane[t];
+        okno_proponowane[t] = okno_zaakceptowane[t] = 0;
+    }
+    kroki_w_oknie = 0;
+}
+
+void StatystykiPrzebiegu::scal(const StatystykiPrzebiegu& inne) {
+    if (inne.liczba == 0) return;
+    if (liczba == 0 || inne.najlepsza_energia < najlepsza_energia) {
+        najlepsza_energia = inne.najlepsza_energia;
+        krok_najlepszej = inne.krok_najlepszej;
+        najlepsza_konformacja = inne.najlepsza_konformacja;
+    }
+    suma += inne.suma;
+    suma_kw += inne.suma_kw;
+    liczba += inne.liczba;
+    for (size_t i = 0; i < inne.histogram.size(); ++i) {
+        if (inne.histogram[i] > 0) {
+            rozszerz_histogram(inne.energia_histogramu + static_cast<int>(i), inne.histogram[i]);
+        }
+    }
+    for (int t = 0; t < LICZBA_TYPOW_RUCHU; ++t) {
+        proponowane[t] += inne.proponowane[t] + inne.okno_proponowane[t];
+        zaakceptowane[t] += inne.zaakceptowane[t] + inne.okno_zaakceptowane[t];
+        akceptacja_okna[t] = inne.akceptacja_okna[t];
+    }
+    // Bloki różnych przebiegów są niezależne - sumy poziomów się dodają
+    if (poziomy.size() < inne.poziomy.size()) poziomy.resize(inne.poziomy.size());
+    for (size_t k = 0; k < inne.poziomy.size(); ++k) {
+        poziomy[k].suma += inne.poziomy[k].suma;
+        poziomy[k].suma_kw += inne.poziomy[k].suma_kw;
+        poziomy[k].liczba += inne.poziomy[k].liczba;
+    }
+}
+
+double StatystykiPrzebiegu::get_srednia() const {
+    return liczba > 0 ? static_cast<double>(suma) / liczba : 0.0;
+}
+
+double StatystykiPrzebiegu::get_wariancja() const {
+    if (liczba < 2) return 0.0;
+    // Sumy są dokładne, więc różnica nie traci precyzji
+    const double n = static_cast<double>(liczba);
+    const double licznik = static_cast<double>(suma_kw) * n - static_cast<double>(suma) * static_cast<double>(suma);
+    return std::max(0.0, licznik / (n * (n - 1)));
+}
+
+uint64_t StatystykiPrzebiegu::get_histogram(int energia) const {
+    const long long indeks = static_cast<long long>(energia) - energia_histogramu;
+    return indeks >= 0 && indeks < static_cast<long long>(histogram.size()) ? histogram[indeks] : 0;
+}
+
+double StatystykiPrzebiegu::get_akceptacja(int typ_ruchu) const {
+    const long long p = proponowane[typ_ruchu] + okno_proponowane[typ_ruchu];
+    return p > 0 ? static_cast<double>(zaakceptowane[typ_ruchu] + okno_zaakceptowane[typ_ruchu]) / p : 0.0;
+}
+
+double StatystykiPrzebiegu::get_akceptacja_okna(int typ_ruchu) const {
+    return akceptacja_okna[typ_ruchu];
+}
+
+double StatystykiPrzebiegu::get_czas_autokorelacji() const {
+    const double wariancja = get_wariancja();
+    if (wariancja <= 0.0) return 0.0;
+
+    // Błąd średniej rośnie z rozmiarem bloku do plateau; bierzemy maksimum z wiarygodnych poziomów
+    double tau = 0.0;
+    for (const Poziom& p : poziomy) {
+        if (p.liczba < MIN_BLOKOW) break;
+        const double n = static_cast<double>(p.liczba);
+        const double wariancja_blokow = std::max(0.0, (p.suma_kw - p.suma * p.suma / n) / (n - 1));
+        tau = std::max(tau, liczba * (wariancja_blokow / n) / (2.0 * wariancja));
+    }
+    return tau;
+}
+
+double StatystykiPrzebiegu::get_blad_sredniej() const {
+    if (liczba == 0) return 0.0;
+    return std::sqrt(2.0 * get_czas_autokorelacji() * get_wariancja() / liczba);
+}
+
+void StatystykiPrzebiegu::zapisz_podsumowanie(std::ostream& out) const {
+    static const char* const NAZWY_RUCHOW[LICZBA_TYPOW_RUCHU] = {"koniec", "naroznik", "crankshaft", "pull"};
+    out << "kroki " << liczba << "\n"
+        << "srednia " << get_srednia() << "\n"
+        << "wariancja " << get_wariancja() << "\n"
+        << "tau " << get_czas_autokorelacji() << "\n"
+        << "blad_sredniej " << get_blad_sredniej() << "\n"
+        << "najlepsza_energia " << (liczba > 0 ? najlepsza_energia : 0) << "\n"
+        << "krok_najlepszej " << krok_najlepszej << "\n";
+    for (int t = 0; t < LICZBA_TYPOW_RUCHU; ++t) {
+        out << "akceptacja_" << NAZWY_RUCHOW[t] << " " << get_akceptacja(t)
+            << " " << get_akceptacja_okna(t) << "\n";
+    }
+    for (size_t i = 0; i < histogram.size(); ++i) {
+        if (histogram[i] > 0) out << "histogram " << energia_histogramu + static_cast<int>(i) << " " << histogram[i] << "\n";
+    }
+}
+
+void StatystykiPrzebiegu::zapisz_stan(ZapisBinarny& zapis) const {
+    zapis.i64(suma);
+    zapis.i64(suma_kw);
+    zapis.i64(liczba);
+    zapis.i32(energia_histogramu);
+    zapis.u32(static_cast<uint32_t>(histogram.size()));
+    for (uint64_t h : histogram) zapis.u64(h);
+    zapis.i32(najlepsza_energia);
+    zapis.i64(krok_najlepszej);
+    zapis.u32(static_cast<uint32_t>(najlepsza_konformacja.size()));
+    for (const auto& p : najlepsza_konformacja) {
+        zapis.i32(p.x);
+        zapis.i32(p.y);
+        zapis.i32(p.z);
+    }
+    zapis.i64(kroki_w_oknie);
+    for (int t = 0; t < LICZBA_TYPOW_RUCHU; ++t) {
+        zapis.i64(okno_proponowane[t]);
+        zapis.i64(okno_zaakceptowane[t]);
+        zapis.i64(proponowane[t]);
+        zapis.i64(zaakceptowane[t]);
+        zapis.f64(akceptacja_okna[t]);
+    }
+    zapis.u32(static_cast<uint32_t>(poziomy.size()));
+    for (const Poziom& p : poziomy) {
+        zapis.f64(p.suma);
+        zapis.f64(p.suma_kw);
+        zapis.i64(p.liczba);
+        zapis.f64(p.oczekujacy);
+        zapis.u32(p.ma_oczekujacy);
+    }
+}
+
+std::function<void()> StatystykiPrzebiegu::odczytaj_stan(OdczytBinarny& odczyt) {
+    // Kopia współdzielona przez zwracaną funkcję (histogram i konformacja bez ponownego kopiowania)
+    auto nowe = std::make_shared<StatystykiPrzebiegu>(*this);
+    nowe->suma = odczyt.i64();
+    nowe->suma_kw = odczyt.i64();
+    nowe->liczba = odczyt.i64();
+    nowe->energia_histogramu = odczyt.i32();
+    nowe->histogram.resize(odczyt.ok() ? odczyt.u32() : 0);
+    for (uint64_t& h : nowe->histogram) h = odczyt.u64();
+    nowe->najlepsza_energia = odczyt.i32();
+    nowe->krok_najlepszej = odczyt.i64();
+    nowe->najlepsza_konformacja.resize(odczyt.ok() ? odczyt.u32() : 0);
+    for (auto& p : nowe->najlepsza_konformacja) {
+        p.x = odczyt.i32();
+        p.y = odczyt.i32();
+        p.z = odczyt.i32();
+    }
+    nowe->kroki_w_oknie = odczyt.i64();
+    for (int t = 0; t < LICZBA_TYPOW_RUCHU; ++t) {
+        nowe->okno_proponowane[t] = odczyt.i64();
+        nowe->okno_zaakceptowane[t] = odczyt.i64();
+        nowe->proponowane[t] = odczyt.i64();
+        nowe->zaakceptowane[t] = odczyt.i64();
+        nowe->akceptacja_okna[t] = odczyt.f64();
+    }
+    nowe->poziomy.resize(odczyt.ok() ? odczyt.u32() : 0);
+    for (Poziom& p : nowe->poziomy) {
+        p.suma = odczyt.f64();
+        p.suma_kw = odczyt.f64();
+        p.liczba = odczyt.i64();
+        p.oczekujacy = odczyt.f64();
+        p.ma_oczekujacy = odczyt.u32() != 0;
+    }
+    return [this, nowe] { *this = std::move(*nowe); };
+}
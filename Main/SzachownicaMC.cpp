@@ -0,0 +1,251 @@
+#include "SzachownicaMC.h"
+#include "PulaWatkow.h"
+#include "Przeglad.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+SzachownicaMC::SzachownicaMC(const UstawieniaSzachownicy& ustawienia)
+    : ustawienia(ustawienia), model(nullptr), dlugosc(0), energia(0), poczatek_podzialu{0, 0, 0}, wymiary{0, 0, 0},
+      przemiatania(0), proponowane(0), zaakceptowane(0), czas(0.0), liczba_watkow(0)
+{
+    // Bok komórki co najmniej 2 (crankshaft potrzebuje kwadratu 2x2), najwyżej 1024
+    this->ustawienia.bity_komorki = std::clamp(this->ustawienia.bity_komorki, 1, 10);
+    if (this->ustawienia.przemiatania_na_podzial <= 0) this->ustawienia.przemiatania_na_podzial = 1;
+}
+
+/**
+ * Podział na komórki z losowym przesunięciem: sortowanie aminokwasów po komórkach
+ * przez zliczanie (O(N), bez sortowania porównaniami) i listy niepustych komórek
+ * każdego koloru. Siatka dostaje pudło obejmujące wszystkie komórki, więc ruchy
+ * wewnątrz komórek nie zmieniają jej rozmiaru.
+ */
+void SzachownicaMC::podziel(Xoshiro256& gen) {
+    const int bity = ustawienia.bity_komorki;
+    const int L = 1 << bity;
+    const std::vector<Vec3>& pozycje = model->pozycje;
+
+    Vec3 min_poz = pozycje[0], max_poz = pozycje[0];
+    for (const auto& p : pozycje) {
+        min_poz = Vec3{std::min(min_poz.x, p.x), std::min(min_poz.y, p.y), std::min(min_poz.z, p.z)};
+        max_poz = Vec3{std::max(max_poz.x, p.x), std::max(max_poz.y, p.y), std::max(max_poz.z, p.z)};
+    }
+    const Vec3 przesuniecie{static_cast<int>(gen.ponizej(L)), static_cast<int>(gen.ponizej(L)),
+                            static_cast<int>(gen.ponizej(L))};
+    poczatek_podzialu = min_poz - przesuniecie;
+    wymiary[0] = ((max_poz.x - poczatek_podzialu.x) >> bity) + 1;
+    wymiary[1] = ((max_poz.y - poczatek_podzialu.y) >> bity) + 1;
+    wymiary[2] = ((max_poz.z - poczatek_podzialu.z) >> bity) + 1;
+    const size_t liczba_komorek = static_cast<size_t>(wymiary[0]) * wymiary[1] * wymiary[2];
+    if (licznik.size() < liczba_komorek) licznik.resize(liczba_komorek, 0);
+
+    model->siatka.dopasuj(poczatek_podzialu, Vec3{poczatek_podzialu.x + (wymiary[0] << bity) - 1,
+                                                  poczatek_podzialu.y + (wymiary[1] << bity) - 1,
+                                                  poczatek_podzialu.z + (wymiary[2] << bity) - 1});
+
+    // Zliczanie; pierwszy aminokwas komórki dopisuje ją do listy jej koloru
+    for (auto& lista : komorki_koloru) lista.clear();
+    komorka_aminokwasu.resize(pozycje.size());
+    for (size_t i = 0; i < pozycje.size(); ++i) {
+        const int cx = (pozycje[i].x - poczatek_podzialu.x) >> bity;
+        const int cy = (pozycje[i].y - poczatek_podzialu.y) >> bity;
+        const int cz = (pozycje[i].z - poczatek_podzialu.z) >> bity;
+        const uint32_t indeks = static_cast<uint32_t>(cx + wymiary[0] * (cy + wymiary[1] * cz));
+        komorka_aminokwasu[i] = indeks;
+        if (licznik[indeks]++ == 0) {
+            komorki_koloru[(cx & 1) | ((cy & 1) << 1) | ((cz & 1) << 2)].push_back({indeks, 0, 0});
+        }
+    }
+
+    // Początki komórek; licznik służy potem jako kursor zapisu
+    uint32_t pierwszy = 0;
+    for (auto& lista : komorki_koloru) {
+        for (auto& komorka : lista) {
+            komorka.pierwszy = pierwszy;
+            komorka.liczba = licznik[komorka.indeks];
+            licznik[komorka.indeks] = pierwszy;
+            pierwszy += komorka.liczba;
+        }
+    }
+    aminokwasy.resize(pozycje.size());
+    for (size_t i = 0; i < pozycje.size(); ++i) {
+        aminokwasy[licznik[komorka_aminokwasu[i]]++] = static_cast<uint32_t>(i);
+    }
+    for (const auto& lista : komorki_koloru) {
+        for (const auto& komorka : lista) licznik[komorka.indeks] = 0;
+    }
+}
+
+/**
+ * Propozycje w jednej komórce: losowy aminokwas komórki, dla końca łańcucha
+ * przesunięcie końca, dla aminokwasu wewnętrznego z równym prawdopodobieństwem
+ * obrót narożnika albo crankshaft (aminokwas jako b), z warunkami jak w ruchach
+ * lokalnych HP_model. Zbiór aminokwasów komórki nie zmienia się w trakcie,
+ * więc propozycje pozostają symetryczne.
+ */
+void SzachownicaMC::przemiataj_komorke(const Komorka& komorka, uint64_t ziarno, double T,
+                                       TablicaAkceptacji& tablica, WynikBloku& wynik) {
+    Xoshiro256 gen(ziarno);
+    const int bity = ustawienia.bity_komorki;
+    const unsigned L = 1u << bity;
+    std::vector<Vec3>& pozycje = model->pozycje;
+    SiatkaZajetosci& siatka = model->siatka;
+    const std::string& sekwencja = model->sekwencja_bialka;
+    const int cx = static_cast<int>(komorka.indeks % wymiary[0]);
+    const int cy = static_cast<int>(komorka.indeks / wymiary[0] % wymiary[1]);
+    const int cz = static_cast<int>(komorka.indeks / wymiary[0] / wymiary[1]);
+    const Vec3 rog{poczatek_podzialu.x + (cx << bity), poczatek_podzialu.y + (cy << bity),
+                   poczatek_podzialu.z + (cz << bity)};
+    auto w_komorce = [&](const Vec3& p) {
+        return static_cast<unsigned>(p.x - rog.x) < L && static_cast<unsigned>(p.y - rog.y) < L &&
+               static_cast<unsigned>(p.z - rog.z) < L;
+    };
+    auto odleglosc = [](const Vec3& a, const Vec3& b) {
+        return std::abs(a.x - b.x) + std::abs(a.y - b.y) + std::abs(a.z - b.z);
+    };
+
+    const size_t n = pozycje.size();
+    for (uint32_t r = 0; r < komorka.liczba; ++r) {
+        const size_t i = aminokwasy[komorka.pierwszy + gen.ponizej(komorka.liczba)];
+        int liczba;
+        Vec3 stare[2], nowe[2];
+
+        if (i == 0 || i + 1 == n) {
+            // Przesunięcie końca
+            if (n < 2) continue;
+            const Vec3 kandydat = pozycje[i == 0 ? 1 : i - 1] + KIERUNKI[gen.ponizej(6)];
+            if (kandydat == pozycje[i] || !w_komorce(kandydat) || !siatka.wolne(kandydat)) continue;
+            liczba = 1;
+            stare[0] = pozycje[i];
+            nowe[0] = kandydat;
+        } else if (gen.ponizej(2) == 0) {
+            // Obrót narożnika
+            const Vec3 kandydat = pozycje[i-1] + pozycje[i+1] - pozycje[i];
+            if (kandydat == pozycje[i] || !w_komorce(kandydat) || !siatka.wolne(kandydat)) continue;
+            liczba = 1;
+            stare[0] = pozycje[i];
+            nowe[0] = kandydat;
+        } else {
+            // Crankshaft: b = i, c = i + 1; c musi należeć do tej samej komórki
+            if (i + 2 >= n) continue;
+            const Vec3 nowe_b = pozycje[i-1] + KIERUNKI[gen.ponizej(6)];
+            const Vec3 nowe_c = pozycje[i+2] + KIERUNKI[gen.ponizej(6)];
+            const Vec3 a = pozycje[i-1], b = pozycje[i], c = pozycje[i+1], d = pozycje[i+2];
+            if ((odleglosc(a, d) != 2 && odleglosc(a, d) != 3) || !w_komorce(c) ||
+                nowe_b == b || nowe_b == c || nowe_b == d || !w_komorce(nowe_b) || !siatka.wolne(nowe_b) ||
+                nowe_c == a || nowe_c == b || nowe_c == c || nowe_c == nowe_b ||
+                !w_komorce(nowe_c) || !siatka.wolne(nowe_c) || odleglosc(nowe_c, nowe_b) != 1) {
+                continue;
+            }
+            liczba = 2;
+            stare[0] = b;
+            stare[1] = c;
+            nowe[0] = nowe_b;
+            nowe[1] = nowe_c;
+        }
+
+        // Ruch w miejscu i ΔE z energii lokalnej przesuniętych aminokwasów (b i c nie tworzą kontaktu)
+        int energia_przed = 0;
+        for (int k = 0; k < liczba; ++k) energia_przed += model->energia_lokalna(i + k);
+        for (int k = 0; k < liczba; ++k) siatka.usun(stare[k]);
+        for (int k = 0; k < liczba; ++k) {
+            pozycje[i + k] = nowe[k];
+            siatka.zajmij(nowe[k], i + k, sekwencja[i + k]);
+        }
+        int energia_po = 0;
+        for (int k = 0; k < liczba; ++k) energia_po += model->energia_lokalna(i + k);
+        const int dE = energia_po - energia_przed;
+
+        if (dE <= 0 || gen() < tablica.prog(dE, T)) {
+            wynik.dE += dE;
+            ++wynik.zaakceptowane;
+            continue;
+        }
+        for (int k = 0; k < liczba; ++k) siatka.usun(nowe[k]);
+        for (int k = 0; k < liczba; ++k) {
+            pozycje[i + k] = stare[k];
+            siatka.zajmij(stare[k], i + k, sekwencja[i + k]);
+        }
+    }
+}
+
+bool SzachownicaMC::uruchom(HP_model& model, double T0, double T_inf, double alpha, long long liczba_przemiatan) {
+    if (model.pozycje.empty()) return false;
+
+    // Siatka modelu jest aktualna po każdej zmianie konformacji, więc nie trzeba jej odbudowywać
+    this->model = &model;
+    dlugosc = model.pozycje.size();
+    energia = model.energia;
+    przemiatania = proponowane = zaakceptowane = 0;
+
+    PulaWatkow pula(ustawienia.watki);
+    liczba_watkow = pula.liczba_watkow();
+    // Kilka bloków komórek na wątek wyrównuje obciążenie przy różnej gęstości komórek
+    const size_t maks_blokow = 4 * liczba_watkow;
+    std::vector<TablicaAkceptacji> tablice(maks_blokow);
+    std::vector<WynikBloku> wyniki;
+
+    Xoshiro256 gen(ustawienia.ziarno);
+    const auto start = std::chrono::steady_clock::now();
+    double T = T0;
+    for (long long s = 0; s < liczba_przemiatan; ++s) {
+        if (s % ustawienia.przemiatania_na_podzial == 0) podziel(gen);
+
+        int kolory[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+        for (int k = 7; k > 0; --k) std::swap(kolory[k], kolory[gen.ponizej(k + 1)]);
+
+        for (int kolor : kolory) {
+            const std::vector<Komorka>& lista = komorki_koloru[kolor];
+            if (lista.empty()) continue;
+            const uint64_t ziarno_koloru = ziarno_przebiegu(ustawienia.ziarno, static_cast<uint64_t>(s) * 8 + kolor);
+            const size_t bloki = std::min(lista.size(), maks_blokow);
+            wyniki.assign(bloki, WynikBloku());
+            for (size_t b = 0; b < bloki; ++b) {
+                pula.dodaj([&, b, ziarno_koloru] {
+                    for (size_t c = b; c < lista.size(); c += bloki) {
+                        przemiataj_komorke(lista[c], ziarno_przebiegu(ziarno_koloru, lista[c].indeks), T,
+                                           tablice[b], wyniki[b]);
+                    }
+                });
+            }
+            pula.czekaj();
+            for (const auto& w : wyniki) {
+                energia += w.dE;
+                zaakceptowane += w.zaakceptowane;
+            }
+        }
+        proponowane += static_cast<long long>(dlugosc);
+        ++przemiatania;
+
+#ifdef HP_SPRAWDZ_ENERGIE
+        // Kontrola spójności energii sumowanej z komórek z pełnym przeliczeniem
+        if (energia != model.energia_z_siatki()) {
+            std::cerr << "Niespójna energia w przemiataniu " << s << ": przyrostowa " << energia
+                      << ", pełna " << model.energia_z_siatki() << std::endl;
+            std::abort();
+        }
+#endif
+        T = std::max(T_inf, T * alpha);
+    }
+    czas = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Jak po ustaw_konformacje: nowa konformacja, dokładne pudło siatki, energia bez przeliczania
+    model.siatka.dopasuj(model.pozycje);
+    model.energia = energia;
+    model.wznowienie = false;
+    this->model = nullptr;
+    return true;
+}
+
+void SzachownicaMC::wypisz_statystyki(std::ostream& out) const {
+    out << "Szachownica: " << dlugosc << " aminokwasów, komórki o boku "
+        << (1 << ustawienia.bity_komorki) << ", wątki: " << liczba_watkow << "\n";
+    out << "Przemiatania: " << przemiatania << ", propozycje: " << proponowane << ", akceptacja: "
+        << (proponowane > 0 ? static_cast<double>(zaakceptowane) / proponowane : 0.0) << "\n";
+    out << "Energia końcowa: " << energia << "\n";
+    if (czas > 0.0) {
+        out << "Czas: " << czas << " s (" << przemiatania / czas << " przemiatań/s, "
+            << proponowane / czas << " propozycji/s)\n";
+    }
+}
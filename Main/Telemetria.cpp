@@ -0,0 +1,52 @@
+#include "Telemetria.h"
+#include <iomanip>
+
+namespace {
+    const char* const NAZWY_FAZ[Telemetria::LICZBA_FAZ] = {
+        "propozycja", "energia", "siatka", "wyjscie"
+    };
+}
+
+/**
+ * Konstruktor: pomiar co 64. krok.
+ */
+Telemetria::Telemetria() : co_ile(64) {
+    rozpocznij();
+}
+
+void Telemetria::rozpocznij() {
+    kroki = 0;
+    zakonczony = false;
+    for (int f = 0; f < LICZBA_FAZ; ++f) {
+        czas_ns[f] = 0;
+        probki[f] = 0;
+    }
+    poczatek = koniec = Zegar::now();
+}
+
+void Telemetria::zakoncz(long kroki) {
+    this->kroki = kroki;
+    koniec = Zegar::now();
+    zakonczony = true;
+}
+
+double Telemetria::kroki_na_sekunde(long krok) const {
+    auto do_chwili = zakonczony ? koniec : Zegar::now();
+    double sekundy = std::chrono::duration<double>(do_chwili - poczatek).count();
+    return sekundy > 0.0 ? krok / sekundy : 0.0;
+}
+
+void Telemetria::raport(std::ostream& out) const {
+    out << "Wydajność: " << std::fixed << std::setprecision(0) << kroki_na_sekunde()
+        << " kroków/s (" << kroki << " kroków)\n";
+    if constexpr (HP_TELEMETRIA != 0) {
+        for (int f = 0; f < LICZBA_FAZ; ++f) {
+            if (probki[f] == 0) continue;
+            out << "  faza " << std::setw(12) << std::left << NAZWY_FAZ[f] << std::right
+                << std::setprecision(1) << static_cast<double>(czas_ns[f]) / probki[f]
+                << " ns średnio (" << probki[f] << " próbek)\n";
+        }
+    }
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
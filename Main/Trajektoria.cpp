@@ -0,0 +1,121 @@
+#include "Trajektoria.h"
+#include <algorithm>
+
+namespace {
+    void zapisz_u32(uint8_t* p, uint32_t v) {
+        for (int b = 0; b < 4; ++b) p[b] = static_cast<uint8_t>(v >> (8 * b));
+    }
+
+    void zapisz_u64(uint8_t* p, uint64_t v) {
+        for (int b = 0; b < 8; ++b) p[b] = static_cast<uint8_t>(v >> (8 * b));
+    }
+
+    uint32_t czytaj_u32(const uint8_t* p) {
+        uint32_t v = 0;
+        for (int b = 0; b < 4; ++b) v |= static_cast<uint32_t>(p[b]) << (8 * b);
+        return v;
+    }
+
+    uint64_t czytaj_u64(const uint8_t* p) {
+        uint64_t v = 0;
+        for (int b = 0; b < 8; ++b) v |= static_cast<uint64_t>(p[b]) << (8 * b);
+        return v;
+    }
+
+    /**
+     * Kod wiązania a -> b: indeks wektora b - a w tablicy KIERUNKI.
+     */
+    unsigned kod_wiazania(const Vec3& a, const Vec3& b) {
+        Vec3 d = b - a;
+        if (d.x != 0) return d.x > 0 ? 0 : 1;
+        if (d.y != 0) return d.y > 0 ? 2 : 3;
+        return d.z > 0 ? 4 : 5;
+    }
+}
+
+std::vector<uint8_t> trajektoria::koduj_naglowek(const std::string& sekwencja, int krok_zapisu) {
+    const size_t n = sekwencja.size();
+    std::vector<uint8_t> naglowek(trajektoria::rozmiar_naglowka(n));
+    for (int b = 0; b < 4; ++b) naglowek[b] = static_cast<uint8_t>(trajektoria::MAGIA[b]);
+    zapisz_u32(&naglowek[4], trajektoria::WERSJA);
+    zapisz_u32(&naglowek[8], static_cast<uint32_t>(n));
+    zapisz_u32(&naglowek[12], static_cast<uint32_t>(krok_zapisu));
+    zapisz_u32(&naglowek[16], static_cast<uint32_t>(trajektoria::rozmiar_klatki(n)));
+    std::copy(sekwencja.begin(), sekwencja.end(), naglowek.begin() + 20);
+    return naglowek;
+}
+
+size_t trajektoria::koduj_klatke(long long krok, int energia, const std::vector<Vec3>& pozycje, uint8_t* bufor) {
+    const size_t rozmiar = trajektoria::rozmiar_klatki(pozycje.size());
+    zapisz_u64(bufor, static_cast<uint64_t>(krok));
+    zapisz_u32(bufor + 8, static_cast<uint32_t>(energia));
+    const Vec3 start = pozycje.empty() ? Vec3{0, 0, 0} : pozycje[0];
+    zapisz_u32(bufor + 12, static_cast<uint32_t>(start.x));
+    zapisz_u32(bufor + 16, static_cast<uint32_t>(start.y));
+    zapisz_u32(bufor + 20, static_cast<uint32_t>(start.z));
+
+    // Kody wiązań po 3 bity, od najmłodszego bitu
+    uint8_t* kody = bufor + 24;
+    for (size_t b = 24; b < rozmiar; ++b) bufor[b] = 0;
+    for (size_t i = 0; i + 1 < pozycje.size(); ++i) {
+        unsigned kod = kod_wiazania(pozycje[i], pozycje[i+1]);
+        size_t bit = 3 * i;
+        kody[bit / 8] |= static_cast<uint8_t>(kod << (bit % 8));
+        if (bit % 8 > 5) kody[bit / 8 + 1] |= static_cast<uint8_t>(kod >> (8 - bit % 8));
+    }
+    return rozmiar;
+}
+
+bool OdczytTrajektorii::otworz(const std::string& sciezka) {
+    plik.open(sciezka, std::ios::binary);
+    if (!plik) return false;
+
+    uint8_t naglowek[4 + 4 * 4];
+    if (!plik.read(reinterpret_cast<char*>(naglowek), sizeof(naglowek))) return false;
+    for (int b = 0; b < 4; ++b) {
+        if (naglowek[b] != static_cast<uint8_t>(trajektoria::MAGIA[b])) return false;
+    }
+    if (czytaj_u32(naglowek + 4) != trajektoria::WERSJA) return false;
+
+    const size_t n = czytaj_u32(naglowek + 8);
+    krok_zapisu = static_cast<int>(czytaj_u32(naglowek + 12));
+    const size_t rozmiar = czytaj_u32(naglowek + 16);
+    if (rozmiar != trajektoria::rozmiar_klatki(n)) return false;
+
+    sekwencja.assign(n, '\0');
+    if (!plik.read(&sekwencja[0], static_cast<std::streamsize>(n))) return false;
+    bufor.assign(rozmiar, 0);
+
+    plik.seekg(0, std::ios::end);
+    const size_t dane = static_cast<size_t>(plik.tellg()) - trajektoria::rozmiar_naglowka(n);
+    klatki = dane / rozmiar;
+    return true;
+}
+
+bool OdczytTrajektorii::czytaj_klatke(size_t k, KlatkaTrajektorii& klatka) {
+    if (k >= klatki) return false;
+    const size_t n = sekwencja.size();
+    plik.clear();
+    plik.seekg(static_cast<std::streamoff>(trajektoria::rozmiar_naglowka(n) + k * bufor.size()));
+    if (!plik.read(reinterpret_cast<char*>(bufor.data()), static_cast<std::streamsize>(bufor.size()))) {
+        return false;
+    }
+
+    klatka.krok = static_cast<long long>(czytaj_u64(bufor.data()));
+    klatka.energia = static_cast<int32_t>(czytaj_u32(bufor.data() + 8));
+    klatka.pozycje.resize(n);
+    if (n == 0) return true;
+    klatka.pozycje[0] = Vec3{
+        static_cast<int32_t>(czytaj_u32(bufor.data() + 12)),
+        static_cast<int32_t>(czytaj_u32(bufor.data() + 16)),
+        static_cast<int32_t>(czytaj_u32(bufor.data() + 20))
+    };
+    const uint8_t* kody = bufor.data() + 24;
+    for (size_t i = 0; i + 1 < n; ++i) {
+        size_t bit = 3 * i;
+        unsigned kod = kody[bit / 8] >> (bit % 8);
+        if (bit % 8 > 5) kod |= static_cast<unsigned>(kody[bit / 8 + 1]) << (8 - bit % 8);
+        klatka.pozycje[i+1] = klatka.pozycje[i] + KIERUNKI[kod & 7];
+    }
+    return true;
+}
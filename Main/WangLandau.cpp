@@ -0,0 +1,151 @@
+#include "WangLandau.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+WangLandau::WangLandau(const UstawieniaWL& ustawienia)
+    : ustawienia(ustawienia), gen(Xoshiro256::strumien(ustawienia.ziarno, 1)), najnizszy_kosz(0),
+      ln_f(ustawienia.ln_f_poczatkowe), kroki(0), iteracje(0)
+{
+}
+
+/**
+ * Histogram płaski: na każdej odwiedzonej energii co najmniej
+ * `plaskosc` razy średnia liczba odwiedzin.
+ */
+bool WangLandau::plaski() const {
+    long long suma = 0, minimum = std::numeric_limits<long long>::max();
+    int liczba = 0;
+    for (size_t b = 0; b < histogram.size(); ++b) {
+        if (!odwiedzone[b]) continue;
+        suma += histogram[b];
+        minimum = std::min(minimum, histogram[b]);
+        ++liczba;
+    }
+    return liczba > 0 && minimum > 0 &&
+           minimum >= ustawienia.plaskosc * static_cast<double>(suma) / liczba;
+}
+
+/**
+ * Pierwsza wizyta energii: ln g startuje od najmniejszej dotąd wartości,
+ * a histogram liczony jest od nowa.
+ */
+void WangLandau::nowy_kosz(size_t b) {
+    double minimum = std::numeric_limits<double>::infinity();
+    for (size_t k = 0; k < ln_g.size(); ++k) {
+        if (odwiedzone[k]) minimum = std::min(minimum, ln_g[k]);
+    }
+    ln_g[b] = std::isfinite(minimum) ? minimum : 0.0;
+    odwiedzone[b] = 1;
+    najnizszy_kosz = std::max(najnizszy_kosz, b);
+    std::fill(histogram.begin(), histogram.end(), 0);
+}
+
+bool WangLandau::uruchom(HP_model& model) {
+    model.ustaw_tryb_propozycji(HP_model::TrybPropozycji::Lokalny);
+    bool sukces = false;
+    for (int proby = 0; !sukces && proby < 1000; ++proby) {
+        sukces = model.generuj_startowa_konformacje(ustawienia.losowa_init);
+    }
+    if (!sukces) return false;
+
+    // Górne ograniczenie liczby kontaktów: H wewnątrz łańcucha ma najwyżej 4
+    // niezwiązanych sąsiadów, H na końcu 5; każdy kontakt liczony dwa razy
+    const std::string& sekwencja = model.get_sekwencja();
+    int maks_sasiedzi = 0;
+    for (size_t i = 0; i < sekwencja.size(); ++i) {
+        if (sekwencja[i] != 'H') continue;
+        maks_sasiedzi += (i == 0 || i + 1 == sekwencja.size()) ? 5 : 4;
+    }
+    size_t liczba_koszy = static_cast<size_t>(maks_sasiedzi / 2) + 1;
+    if (ustawienia.energia_minimalna < 0) {
+        liczba_koszy = std::min(liczba_koszy, static_cast<size_t>(-ustawienia.energia_minimalna) + 1);
+    }
+    ln_g.assign(liczba_koszy, 0.0);
+    histogram.assign(liczba_koszy, 0);
+    odwiedzone.assign(liczba_koszy, 0);
+    najnizszy_kosz = 0;
+    ln_f = ustawienia.ln_f_poczatkowe;
+    kroki = 0;
+    iteracje = 0;
+    bool faza_1_t = false;
+
+    // Start poniżej okna: schodzimy do okna zwykłym Metropolisem
+    while (static_cast<size_t>(-model.get_energia()) >= liczba_koszy) {
+        model.krok_mc(10.0);
+    }
+    nowy_kosz(static_cast<size_t>(-model.get_energia()));
+
+    while (ln_f >= ustawienia.ln_f_koncowe && kroki < ustawienia.maks_krokow) {
+        model.krok([&](int dE, double log_stosunek) {
+            const size_t stary = static_cast<size_t>(-model.get_energia());
+            const size_t nowy = static_cast<size_t>(-(model.get_energia() + dE));
+            if (nowy >= ln_g.size()) return false;  // poza oknem energii
+            if (!odwiedzone[nowy]) nowy_kosz(nowy);
+            const double roznica = ln_g[stary] - ln_g[nowy] + log_stosunek;
+            return roznica >= 0.0 || gen.jednostajna() < std::exp(roznica);
+        });
+        ++kroki;
+
+        const size_t b = static_cast<size_t>(-model.get_energia());
+        ln_g[b] += ln_f;
+        ++histogram[b];
+
+        if (kroki % ustawienia.interwal_sprawdzania != 0) continue;
+
+        // Liczba odwiedzonych energii wyznacza czas t = kroki / kosze
+        const double kosze = static_cast<double>(std::count(odwiedzone.begin(), odwiedzone.end(), 1));
+        const double jeden_przez_t = kosze / static_cast<double>(kroki);
+        if (faza_1_t) {
+            ln_f = jeden_przez_t;
+        } else if (plaski()) {
+            ln_f /= 2.0;
+            ++iteracje;
+            std::fill(histogram.begin(), histogram.end(), 0);
+            if (ustawienia.schemat_1_t && ln_f < jeden_przez_t) {
+                faza_1_t = true;
+                ln_f = jeden_przez_t;
+            }
+        }
+    }
+    return true;
+}
+
+bool WangLandau::zapisz_gestosc(const std::string& sciezka) const {
+    std::ofstream plik(sciezka);
+    if (!plik) return false;
+    plik << "# E ln_g H\n";
+    plik.precision(12);
+    for (size_t b = najnizszy_kosz + 1; b-- > 0; ) {
+        if (!odwiedzone[b]) continue;
+        plik << -static_cast<int>(b) << " " << ln_g[b] - ln_g[najnizszy_kosz] << " " << histogram[b] << "\n";
+    }
+    return static_cast<bool>(plik);
+}
+
+void WangLandau::termodynamika(double T, double& srednia_energia, double& cieplo_wlasciwe) const {
+    // Wagi g(E) exp(-E/T) liczone względem największej, bez przepełnienia
+    double maks = -std::numeric_limits<double>::infinity();
+    for (size_t b = 0; b < ln_g.size(); ++b) {
+        if (odwiedzone[b]) maks = std::max(maks, ln_g[b] + static_cast<double>(b) / T);
+    }
+    double Z = 0.0, suma_E = 0.0, suma_E2 = 0.0;
+    for (size_t b = 0; b < ln_g.size(); ++b) {
+        if (!odwiedzone[b]) continue;
+        const double E = -static_cast<double>(b);
+        const double w = std::exp(ln_g[b] - E / T - maks);
+        Z += w;
+        suma_E += w * E;
+        suma_E2 += w * E * E;
+    }
+    srednia_energia = Z > 0.0 ? suma_E / Z : 0.0;
+    cieplo_wlasciwe = Z > 0.0 ? (suma_E2 / Z - srednia_energia * srednia_energia) / (T * T) : 0.0;
+}
+
+void WangLandau::wypisz_statystyki(std::ostream& out) const {
+    out << "Wang-Landau: kroki " << kroki << ", zmniejszenia ln f " << iteracje
+        << ", końcowe ln f " << ln_f << "\n";
+    out << "Zakres energii: " << get_energia_minimalna() << " .. "
+        << -static_cast<int>(std::find(odwiedzone.begin(), odwiedzone.end(), 1) - odwiedzone.begin()) << "\n";
+}
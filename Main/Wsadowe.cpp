@@ -0,0 +1,135 @@
+#include "Wsadowe.h"
+#include "hp_core.h"
+#include "Przeglad.h"
+#include "Vec3.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Sekwencja bieżącego okna z buforem na konformację zwracaną przez hp_core
+    struct Wpis {
+        size_t indeks;
+        std::string nazwa;
+        std::string sekwencja;
+        std::vector<int32_t> konformacja;
+    };
+
+    /**
+     * Kierunki kolejnych wiązań jako litery (kolejność jak w KIERUNKI).
+     */
+    std::string koduj_konformacje(const std::vector<int32_t>& xyz, size_t dlugosc) {
+        static const char LITERY[6] = {'R', 'L', 'U', 'D', 'F', 'B'};
+        std::string kod;
+        kod.reserve(dlugosc);
+        for (size_t i = 0; i + 1 < dlugosc; ++i) {
+            const Vec3 d{xyz[3 * (i + 1)] - xyz[3 * i], xyz[3 * (i + 1) + 1] - xyz[3 * i + 1],
+                         xyz[3 * (i + 1) + 2] - xyz[3 * i + 2]};
+            for (int k = 0; k < 6; ++k) {
+                if (KIERUNKI[k] == d) kod += LITERY[k];
+            }
+        }
+        return kod;
+    }
+
+    const char* status_csv(int status) {
+        switch (status) {
+            case HP_OK: return "ok";
+            case HP_BLAD_SEKWENCJI: return "niepoprawna_sekwencja";
+            case HP_BLAD_STARTU: return "brak_konformacji";
+            default: return "blad";
+        }
+    }
+
+    // Pole CSV: cudzysłów tylko wtedy, gdy to konieczne
+    std::string pole_csv(const std::string& s) {
+        if (s.find_first_of(",\"\n") == std::string::npos) return s;
+        std::string wynik = "\"";
+        for (char c : s) {
+            if (c == '"') wynik += '"';
+            wynik += c;
+        }
+        return wynik + "\"";
+    }
+}
+
+StatystykiWsadowe przetworz_wsadowo(std::istream& wejscie, std::ostream& wyjscie,
+                                    const UstawieniaWsadowe& ustawienia) {
+    const auto start = std::chrono::steady_clock::now();
+    StatystykiWsadowe statystyki{0, 0, 0.0};
+
+    size_t watki = ustawienia.watki > 0 ? ustawienia.watki : std::thread::hardware_concurrency();
+    if (watki == 0) watki = 1;
+    const size_t okno = ustawienia.okno > 0 ? ustawienia.okno : 4 * watki;
+    std::vector<Wpis> wpisy;
+    std::vector<hp_zadanie> zadania;
+    wpisy.reserve(okno);
+    zadania.reserve(okno);
+
+    wyjscie << "Indeks,Nazwa,Dlugosc,Status,Energia,Czas_s,Konformacja\n";
+
+    // Zwija całe okno jednym wywołaniem hp_zwin_wsadowo i zapisuje wiersze w kolejności wejścia
+    auto zwin_okno = [&]() {
+        zadania.clear();
+        for (Wpis& w : wpisy) {
+            hp_zadanie z{};
+            z.sekwencja = w.sekwencja.c_str();
+            hp_parametry_domyslne(&z.parametry);
+            z.parametry.T0 = ustawienia.T0;
+            z.parametry.T_inf = ustawienia.T_inf;
+            z.parametry.alpha = ustawienia.alpha;
+            z.parametry.ziarno = ziarno_przebiegu(ustawienia.ziarno, w.indeks);
+            z.parametry.lokalne_ruchy = 1;
+            // Poniżej 4 aminokwasów kontakt H-H jest niemożliwy - wystarczy linia prosta
+            const bool krotka = w.sekwencja.size() < 4;
+            z.parametry.kroki = krotka ? 0 : ustawienia.kroki;
+            z.parametry.losowa_init = krotka ? 0 : 1;
+            w.konformacja.assign(3 * w.sekwencja.size(), 0);
+            z.konformacja = w.konformacja.data();
+            z.pojemnosc = w.sekwencja.size();
+            zadania.push_back(z);
+        }
+        hp_zwin_wsadowo(zadania.data(), zadania.size(), watki);
+
+        for (size_t k = 0; k < wpisy.size(); ++k) {
+            const Wpis& w = wpisy[k];
+            const hp_zadanie& z = zadania[k];
+            wyjscie << w.indeks << "," << pole_csv(w.nazwa) << "," << w.sekwencja.size() << ","
+                    << status_csv(z.status) << ",";
+            if (z.status == HP_OK) {
+                wyjscie << z.energia;
+            } else {
+                ++statystyki.bledne;
+            }
+            wyjscie << "," << z.czas << ","
+                    << (z.status == HP_OK ? koduj_konformacje(w.konformacja, z.dlugosc) : std::string()) << "\n";
+        }
+        wpisy.clear();
+    };
+
+    std::string linia;
+    while (std::getline(wejscie, linia)) {
+        std::istringstream pola(linia);
+        std::string pierwsze, drugie;
+        if (!(pola >> pierwsze) || pierwsze[0] == '#') continue;
+        pola >> drugie;
+
+        Wpis w;
+        w.indeks = statystyki.sekwencje++;
+        w.nazwa = drugie.empty() ? std::string() : pierwsze;
+        w.sekwencja = drugie.empty() ? pierwsze : drugie;
+        std::transform(w.sekwencja.begin(), w.sekwencja.end(), w.sekwencja.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+        wpisy.push_back(std::move(w));
+        if (wpisy.size() == okno) zwin_okno();
+    }
+    if (!wpisy.empty()) zwin_okno();
+    wyjscie.flush();
+
+    statystyki.czas = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return statystyki;
+}
@@ -0,0 +1,237 @@
+#include "WymianaReplik.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+    /**
+     * Bariera wielokrotnego użytku dla stałej liczby wątków.
+     * Ostatni przybyły wątek wykonuje `zakonczenie` (pod blokadą), zanim
+     * pozostałe ruszą dalej, więc jego zapisy są dla nich widoczne.
+     */
+    class Bariera {
+    public:
+        explicit Bariera(size_t liczba) : liczba(liczba), czekajace(0), pokolenie(0) {}
+
+        template <typename F>
+        void czekaj(F&& zakonczenie) {
+            std::unique_lock<std::mutex> blokada(mutex);
+            const size_t moje_pokolenie = pokolenie;
+            if (++czekajace == liczba) {
+                zakonczenie();
+                czekajace = 0;
+                ++pokolenie;
+                blokada.unlock();
+                sygnal.notify_all();
+                return;
+            }
+            sygnal.wait(blokada, [&] { return pokolenie != moje_pokolenie; });
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable sygnal;
+        size_t liczba;
+        size_t czekajace;
+        size_t pokolenie;
+    };
+
+    // Wzmocnienie sprzężenia zwrotnego przy dopasowaniu drabiny
+    const double WZMOCNIENIE_ADAPTACJI = 2.0;
+}
+
+WymianaReplik::WymianaReplik(const UstawieniaWymiany& ustawienia)
+    : ustawienia(ustawienia), najlepsza_energia(0), czas_do_celu(-1.0), czas(0.0)
+{
+    if (this->ustawienia.liczba_replik <= 0) {
+        this->ustawienia.liczba_replik = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    this->ustawienia.liczba_replik = std::max(this->ustawienia.liczba_replik, 2);
+    if (this->ustawienia.kroki_miedzy_wymianami <= 0) this->ustawienia.kroki_miedzy_wymianami = 1;
+    if (this->ustawienia.interwal_adaptacji <= 0) this->ustawienia.interwal_adaptacji = 1;
+
+    // Drabina geometryczna jako punkt wyjścia
+    const size_t K = static_cast<size_t>(this->ustawienia.liczba_replik);
+    temperatury.resize(K);
+    for (size_t i = 0; i < K; ++i) {
+        temperatury[i] = this->ustawienia.T_min *
+            std::pow(this->ustawienia.T_max / this->ustawienia.T_min, static_cast<double>(i) / (K - 1));
+    }
+}
+
+/**
+ * Zmienia odstępy drabiny (w skali log T) tak, by częstość wymian każdej
+ * pary zbliżała się do docelowej: pary wymieniające się zbyt często
+ * rozsuwamy, zbyt rzadko - zsuwamy. Skrajne temperatury pozostają stałe.
+ */
+void WymianaReplik::dopasuj_drabine(const std::vector<StatystykiPary>& okno) {
+    const size_t K = temperatury.size();
+    std::vector<double> odstepy(K - 1);
+    double suma = 0.0;
+    for (size_t i = 0; i + 1 < K; ++i) {
+        double akceptacja = okno[i].proby > 0
+            ? static_cast<double>(okno[i].udane) / okno[i].proby
+            : ustawienia.docelowa_akceptacja;
+        odstepy[i] = std::log(temperatury[i+1] / temperatury[i]) *
+            std::exp(WZMOCNIENIE_ADAPTACJI * (akceptacja - ustawienia.docelowa_akceptacja));
+        suma += odstepy[i];
+    }
+
+    const double zakres = std::log(ustawienia.T_max / ustawienia.T_min);
+    double log_T = std::log(ustawienia.T_min);
+    for (size_t i = 0; i + 1 < K; ++i) {
+        log_T += odstepy[i] * zakres / suma;
+        temperatury[i+1] = std::exp(log_T);
+    }
+    temperatury[K-1] = ustawienia.T_max;
+}
+
+bool WymianaReplik::uruchom() {
+    const size_t K = temperatury.size();
+    const int cel = ustawienia.energia_docelowa;
+
+    // Repliki z niezależnymi strumieniami generatora, każda w osobnej alokacji,
+    // żeby liczniki replik nie dzieliły linii pamięci podręcznej
+    std::vector<std::unique_ptr<HP_model>> modele;
+    for (size_t r = 0; r < K; ++r) {
+        modele.push_back(ustawienia.sekwencja.empty() ? std::make_unique<HP_model>()
+                                                      : std::make_unique<HP_model>(ustawienia.sekwencja));
+        HP_model& model = *modele[r];
+        model.ustaw_strumien(ustawienia.ziarno, r);
+        model.ustaw_gadatliwosc(Gadatliwosc::Cisza);
+        model.ustaw_tryb_propozycji(ustawienia.tryb);
+        bool sukces = false;
+        for (int proby = 0; !sukces && proby < 1000; ++proby) {
+            sukces = model.generuj_startowa_konformacje(ustawienia.losowa_init);
+        }
+        if (!sukces) return false;
+    }
+
+    statystyki.assign(K, StatystykiRepliki{});
+    pary.assign(K - 1, StatystykiPary{});
+    std::vector<StatystykiPary> okno(K - 1);
+    std::vector<std::vector<Vec3>> najlepsze(K);
+
+    // poziom[r] - indeks temperatury repliki r; replika[i] - replika w temperaturze i
+    std::vector<size_t> poziom(K), replika(K);
+    for (size_t r = 0; r < K; ++r) poziom[r] = replika[r] = r;
+    std::vector<int> energie(K);
+    std::vector<long long> wymiany(K, 0);
+
+    Xoshiro256 gen_wymian = Xoshiro256::strumien(ustawienia.ziarno, K);
+    std::atomic<bool> stop(false);
+    bool koniec = false;
+    long long runda = 0;
+    Bariera bariera(K);
+    const auto start = std::chrono::steady_clock::now();
+
+    // Runda wymian: wykonywana przez ostatni wątek na barierze
+    auto wymiana = [&] {
+        for (size_t i = runda % 2; i + 1 < K; i += 2) {
+            const size_t a = replika[i], b = replika[i+1];
+            const double delta = (1.0 / temperatury[i] - 1.0 / temperatury[i+1]) * (energie[a] - energie[b]);
+            ++pary[i].proby;
+            ++okno[i].proby;
+            if (delta >= 0.0 || gen_wymian.jednostajna() < std::exp(delta)) {
+                std::swap(replika[i], replika[i+1]);
+                poziom[a] = i + 1;
+                poziom[b] = i;
+                ++pary[i].udane;
+                ++okno[i].udane;
+                ++wymiany[a];
+                ++wymiany[b];
+            }
+        }
+        ++runda;
+
+        if (ustawienia.adaptacja_drabiny && runda % ustawienia.interwal_adaptacji == 0) {
+            dopasuj_drabine(okno);
+            std::fill(okno.begin(), okno.end(), StatystykiPary{});
+        }
+        // Cel sprawdzany tylko tutaj: każda replika kończy pełną rundę, więc liczby
+        // kroków i wynik nie zależą od przeplotu wątków
+        koniec = stop.load(std::memory_order_relaxed) ||
+                 runda * ustawienia.kroki_miedzy_wymianami >= ustawienia.maks_krokow;
+    };
+
+    auto petla_repliki = [&](size_t r) {
+        HP_model& model = *modele[r];
+        StatystykiRepliki stat; // lokalnie w wątku, zapisywane na końcu
+        stat.najlepsza_energia = static_cast<int>(model.get_energia());
+        najlepsze[r] = model.get_pozycje();
+
+        while (true) {
+            const double T = temperatury[poziom[r]];
+            for (int k = 0; k < ustawienia.kroki_miedzy_wymianami; ++k) {
+                if (model.krok_mc(T)) ++stat.zaakceptowane;
+                ++stat.kroki;
+
+                const int E = static_cast<int>(model.get_energia());
+                if (E < stat.najlepsza_energia) {
+                    stat.najlepsza_energia = E;
+                    najlepsze[r] = model.get_pozycje();
+                    if (cel != 0 && E <= cel && stat.czas_do_celu < 0.0) {
+                        stat.czas_do_celu = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start).count();
+                        stop.store(true, std::memory_order_relaxed);
+                    }
+                }
+            }
+            energie[r] = static_cast<int>(model.get_energia());
+            bariera.czekaj(wymiana);
+            if (koniec) break;
+        }
+        stat.energia = static_cast<int>(model.get_energia());
+        statystyki[r] = stat;
+    };
+
+    std::vector<std::thread> watki;
+    for (size_t r = 0; r < K; ++r) watki.emplace_back(petla_repliki, r);
+    for (auto& watek : watki) watek.join();
+    czas = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (size_t r = 0; r < K; ++r) statystyki[r].wymiany = wymiany[r];
+
+    // Najlepsza konformacja spośród wszystkich replik
+    size_t najlepsza = 0;
+    czas_do_celu = -1.0;
+    for (size_t r = 0; r < K; ++r) {
+        if (statystyki[r].najlepsza_energia < statystyki[najlepsza].najlepsza_energia) najlepsza = r;
+        if (statystyki[r].czas_do_celu >= 0.0 &&
+            (czas_do_celu < 0.0 || statystyki[r].czas_do_celu < czas_do_celu)) {
+            czas_do_celu = statystyki[r].czas_do_celu;
+        }
+    }
+    najlepsza_energia = statystyki[najlepsza].najlepsza_energia;
+    najlepsza_konformacja = std::move(najlepsze[najlepsza]);
+    return true;
+}
+
+void WymianaReplik::wypisz_statystyki(std::ostream& out) const {
+    out << "Drabina temperatur (częstość wymian z wyższą temperaturą):\n";
+    for (size_t i = 0; i < temperatury.size(); ++i) {
+        out << "  T[" << i << "] = " << std::setw(8) << temperatury[i];
+        if (i < pary.size() && pary[i].proby > 0) {
+            out << "  wymiany: " << static_cast<double>(pary[i].udane) / pary[i].proby;
+        }
+        out << "\n";
+    }
+    out << std::setw(8) << "Replika" << std::setw(12) << "Kroki" << std::setw(12) << "Akceptacja"
+        << std::setw(10) << "Energia" << std::setw(12) << "Najlepsza" << std::setw(10) << "Wymiany" << "\n";
+    for (size_t r = 0; r < statystyki.size(); ++r) {
+        const StatystykiRepliki& s = statystyki[r];
+        out << std::setw(8) << r << std::setw(12) << s.kroki
+            << std::setw(12) << (s.kroki > 0 ? static_cast<double>(s.zaakceptowane) / s.kroki : 0.0)
+            << std::setw(10) << s.energia << std::setw(12) << s.najlepsza_energia
+            << std::setw(10) << s.wymiany << "\n";
+    }
+    out << "Najlepsza energia: " << najlepsza_energia << ", czas: " << czas << " s";
+    if (czas_do_celu >= 0.0) out << ", cel osiągnięty po " << czas_do_celu << " s";
+    out << "\n";
+}
@@ -0,0 +1,183 @@
+#include "ZapisAsynchroniczny.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+    // Górna granica współczynnika decymacji
+    constexpr uint32_t MAKS_DECYMACJA = 1024;
+}
+
+/**
+ * Konstruktor: przydziela całą pamięć buforów; wszystkie trafiają do kolejki pustych.
+ */
+ZapisAsynchroniczny::ZapisAsynchroniczny(size_t liczba_buforow, size_t rozmiar_bufora)
+    : bufory(std::max<size_t>(liczba_buforow, 2)),
+      pelne(bufory.size()), puste(bufory.size()),
+      decymacja(1), pominiete(0), polityka(Polityka::Blokuj),
+      koniec(false), dziala(false)
+{
+    for (uint32_t i = 0; i < bufory.size(); ++i) {
+        bufory[i].strumien = 0;
+        bufory[i].zajete = 0;
+        bufory[i].dane.resize(std::max<size_t>(rozmiar_bufora, 64));
+        puste.wstaw(i);
+    }
+    for (int s = 0; s < LICZBA_STRUMIENI; ++s) {
+        biezacy[s] = -1;
+        licznik_rekordow[s] = 0;
+        dlugosc[s] = 0;
+    }
+}
+
+ZapisAsynchroniczny::~ZapisAsynchroniczny() {
+    zakoncz();
+}
+
+bool ZapisAsynchroniczny::otworz(Strumien strumien, const std::string& sciezka, uint64_t od_bajtu) {
+    dlugosc[strumien] = od_bajtu;
+    if (od_bajtu == 0) {
+        pliki[strumien].open(sciezka, std::ios::binary | std::ios::trunc);
+        return static_cast<bool>(pliki[strumien]);
+    }
+
+    // Kontynuacja: odcinamy rekordy zapisane po punkcie kontrolnym
+    namespace fs = std::filesystem;
+    std::error_code blad;
+    if (fs::file_size(sciezka, blad) < od_bajtu || blad) return false;
+    fs::resize_file(sciezka, od_bajtu, blad);
+    if (blad) return false;
+    pliki[strumien].open(sciezka, std::ios::binary | std::ios::app);
+    return static_cast<bool>(pliki[strumien]);
+}
+
+void ZapisAsynchroniczny::rozpocznij() {
+    if (dziala) return;
+    koniec.store(false);
+    dziala = true;
+    watek = std::thread(&ZapisAsynchroniczny::petla_zapisu, this);
+}
+
+/**
+ * Pobiera pusty bufor dla strumienia; przy czekaj = false nie czeka na dysk.
+ */
+bool ZapisAsynchroniczny::wez_bufor(int strumien, bool czekaj) {
+    uint32_t idx;
+    while (!puste.pobierz(idx)) {
+        if (!czekaj) return false;
+        sygnal.notify_one();
+        std::this_thread::yield();
+    }
+    bufory[idx].strumien = strumien;
+    bufory[idx].zajete = 0;
+    biezacy[strumien] = idx;
+
+    // Zapis nadąża - łagodzimy decymację
+    if (decymacja > 1 && puste.rozmiar() > bufory.size() / 2) decymacja /= 2;
+    return true;
+}
+
+/**
+ * Przekazuje bieżący bufor strumienia do wątku zapisu.
+ */
+void ZapisAsynchroniczny::wyslij(int strumien) {
+    if (biezacy[strumien] < 0) return;
+    // Kolejka pełnych mieści wszystkie bufory, więc wstawienie zawsze się udaje
+    pelne.wstaw(static_cast<uint32_t>(biezacy[strumien]));
+    biezacy[strumien] = -1;
+    sygnal.notify_one();
+}
+
+bool ZapisAsynchroniczny::zapisz(Strumien strumien, const void* dane, size_t n, bool wymagany) {
+    const size_t pojemnosc = bufory[0].dane.size();
+    const bool czekaj = wymagany || polityka == Polityka::Blokuj || n > pojemnosc;
+
+    if (polityka == Polityka::Decymuj && !wymagany &&
+        licznik_rekordow[strumien]++ % decymacja != 0) {
+        ++pominiete;
+        return false;
+    }
+
+    const char* zrodlo = static_cast<const char*>(dane);
+    while (n > 0) {
+        if (biezacy[strumien] >= 0 &&
+            bufory[biezacy[strumien]].zajete + std::min(n, pojemnosc) > pojemnosc) {
+            wyslij(strumien);
+        }
+        if (biezacy[strumien] < 0 && !wez_bufor(strumien, czekaj)) {
+            ++pominiete;
+            if (polityka == Polityka::Decymuj) decymacja = std::min(decymacja * 2, MAKS_DECYMACJA);
+            return false;
+        }
+        Bufor& bufor = bufory[biezacy[strumien]];
+        size_t porcja = std::min(n, pojemnosc - bufor.zajete);
+        std::memcpy(bufor.dane.data() + bufor.zajete, zrodlo, porcja);
+        bufor.zajete += porcja;
+        zrodlo += porcja;
+        n -= porcja;
+    }
+    dlugosc[strumien] += zrodlo - static_cast<const char*>(dane);
+    return true;
+}
+
+/**
+ * Zapisuje pełny bufor do pliku jego strumienia i zwraca go do kolejki pustych.
+ */
+void ZapisAsynchroniczny::zapisz_bufor(uint32_t idx) {
+    Bufor& bufor = bufory[idx];
+    pliki[bufor.strumien].write(bufor.dane.data(), static_cast<std::streamsize>(bufor.zajete));
+    bufor.zajete = 0;
+    puste.wstaw(idx);
+}
+
+void ZapisAsynchroniczny::petla_zapisu() {
+    uint32_t idx;
+    while (true) {
+        if (pelne.pobierz(idx)) {
+            zapisz_bufor(idx);
+            continue;
+        }
+        if (koniec.load(std::memory_order_acquire)) {
+            while (pelne.pobierz(idx)) zapisz_bufor(idx);
+            break;
+        }
+        std::unique_lock<std::mutex> blokada(mutex);
+        sygnal.wait_for(blokada, std::chrono::milliseconds(10), [this] {
+            return pelne.rozmiar() > 0 || koniec.load(std::memory_order_acquire);
+        });
+    }
+}
+
+void ZapisAsynchroniczny::oproznij() {
+    for (int s = 0; s < LICZBA_STRUMIENI; ++s) wyslij(s);
+    if (dziala) {
+        // Wszystkie bufory wróciły do pustych - wątek zapisu nie ma nic w toku
+        while (puste.rozmiar() < bufory.size()) {
+            sygnal.notify_one();
+            std::this_thread::yield();
+        }
+    } else {
+        uint32_t idx;
+        while (pelne.pobierz(idx)) zapisz_bufor(idx);
+    }
+    for (auto& plik : pliki) {
+        if (plik.is_open()) plik.flush();
+    }
+}
+
+void ZapisAsynchroniczny::zakoncz() {
+    for (int s = 0; s < LICZBA_STRUMIENI; ++s) wyslij(s);
+    koniec.store(true, std::memory_order_release);
+    if (dziala) {
+        sygnal.notify_one();
+        watek.join();
+        dziala = false;
+    } else {
+        // Wątek nie został uruchomiony - zapis synchroniczny tego, co zostało
+        petla_zapisu();
+    }
+    for (auto& plik : pliki) {
+        if (plik.is_open()) plik.close();
+    }
+}
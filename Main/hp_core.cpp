@@ -0,0 +1,119 @@
+#include "hp_core.h"
+#include "HP_model.h"
+#include "Harmonogram.h"
+#include "PulaWatkow.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <memory>
+#include <string>
+
+namespace {
+    bool poprawna_sekwencja(const std::string& s) {
+        return !s.empty() && std::all_of(s.begin(), s.end(), [](char c) { return c == 'H' || c == 'P'; });
+    }
+
+    int wykonaj(hp_zadanie& z) {
+        const hp_parametry& p = z.parametry;
+        if (!z.sekwencja || p.kroki < 0 || p.kroki > INT_MAX || !(p.T0 > 0.0) || !(p.T_inf > 0.0) ||
+            !(p.alpha > 0.0)) {
+            return HP_BLAD_ARGUMENTU;
+        }
+        const std::string sekwencja(z.sekwencja);
+        z.dlugosc = sekwencja.size();
+        if (!poprawna_sekwencja(sekwencja)) return HP_BLAD_SEKWENCJI;
+
+        // Model bez plików i komunikatów - wynik tylko w zadaniu
+        HP_model model(sekwencja);
+        model.ustaw_gadatliwosc(Gadatliwosc::Cisza);
+        model.ustaw_interwal_raportu(0);
+        model.ustaw_zapis_plikow(false);
+        model.ustaw_ziarno(p.ziarno);
+        if (p.lokalne_ruchy) model.ustaw_tryb_propozycji(HP_model::TrybPropozycji::Lokalny);
+        if (!model.generuj_startowa_konformacje(p.losowa_init != 0)) return HP_BLAD_STARTU;
+
+        std::unique_ptr<DetektorZbieznosci> detektor;
+        if (p.wczesne_zakonczenie) {
+            detektor = std::make_unique<DetektorZbieznosci>(UstawieniaZbieznosci());
+            model.ustaw_detektor_zbieznosci(detektor.get());
+        }
+        model.algorytm_metropolisa(p.T0, p.T_inf, p.alpha, static_cast<int>(p.kroki));
+
+        // Wynikiem jest najlepszy stan przebiegu, nie końcowy stan wyżarzania
+        z.energia = static_cast<int32_t>(model.get_najlepsza_energia());
+        z.wykonane_kroki = model.get_kroki_przebiegu();
+        if (!z.konformacja) return HP_OK;
+        if (z.pojemnosc < z.dlugosc) return HP_BLAD_BUFORA;
+        const std::vector<Vec3>& pozycje = model.get_najlepsze_pozycje();
+        for (size_t i = 0; i < pozycje.size(); ++i) {
+            z.konformacja[3 * i] = pozycje[i].x;
+            z.konformacja[3 * i + 1] = pozycje[i].y;
+            z.konformacja[3 * i + 2] = pozycje[i].z;
+        }
+        return HP_OK;
+    }
+}
+
+extern "C" {
+
+int hp_wersja_api(void) {
+    return HP_API_WERSJA;
+}
+
+void hp_parametry_domyslne(hp_parametry* parametry) {
+    if (!parametry) return;
+    parametry->T0 = 10.0;
+    parametry->T_inf = 0.5;
+    parametry->alpha = 0.999;
+    parametry->kroki = 10000;
+    parametry->ziarno = 1;
+    parametry->losowa_init = 1;
+    parametry->wczesne_zakonczenie = 0;
+    parametry->lokalne_ruchy = 0;
+}
+
+int hp_zwin(hp_zadanie* zadanie) {
+    if (!zadanie) return HP_BLAD_ARGUMENTU;
+    zadanie->energia = 0;
+    zadanie->wykonane_kroki = 0;
+    zadanie->dlugosc = 0;
+    const auto start = std::chrono::steady_clock::now();
+    // Wyjątki nie mogą przejść przez granicę API w C
+    try {
+        zadanie->status = wykonaj(*zadanie);
+    } catch (...) {
+        zadanie->status = HP_BLAD_WEWNETRZNY;
+    }
+    zadanie->czas = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return zadanie->status;
+}
+
+size_t hp_zwin_wsadowo(hp_zadanie* zadania, size_t liczba, size_t watki) {
+    if (!zadania || liczba == 0) return 0;
+    try {
+        PulaWatkow pula(watki == 0 ? 0 : std::min(watki, liczba));
+        for (size_t i = 0; i < liczba; ++i) {
+            pula.dodaj([zadania, i] { hp_zwin(&zadania[i]); });
+        }
+        pula.czekaj();
+    } catch (...) {
+        // Pula nie powstała - zadania wykonywane (od nowa, z tym samym wynikiem) w wątku wywołującym
+        for (size_t i = 0; i < liczba; ++i) hp_zwin(&zadania[i]);
+    }
+    return static_cast<size_t>(std::count_if(zadania, zadania + liczba,
+                                             [](const hp_zadanie& z) { return z.status == HP_OK; }));
+}
+
+const char* hp_opis_statusu(int status) {
+    switch (status) {
+        case HP_OK: return "ok";
+        case HP_BLAD_ARGUMENTU: return "niepoprawne argumenty";
+        case HP_BLAD_SEKWENCJI: return "niepoprawna sekwencja (dozwolone tylko H i P)";
+        case HP_BLAD_BUFORA: return "bufor konformacji za mały";
+        case HP_BLAD_STARTU: return "nie udało się wygenerować konformacji startowej";
+        case HP_BLAD_WEWNETRZNY: return "błąd wewnętrzny";
+        default: return "nieznany status";
+    }
+}
+
+}
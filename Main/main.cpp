@@ -1,23 +1,24 @@
 #include "../Header/HP_model.h"
+#include "../Header/Przeglad.h"
+#include "../Header/WymianaReplik.h"
+#include "../Header/PERM.h"
+#include "../Header/WangLandau.h"
+#include "../Header/Wsadowe.h"
+#include "../Header/Enumeracja.h"
+#include "../Header/PamiecKonformacji.h"
+#include "../Header/Harmonogram.h"
+#include "../Header/StatystykiPrzebiegu.h"
+#include "../Header/hp_core.h"
+#include "../Header/SzachownicaMC.h"
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 #include <vector>
 #include <string>
 #include <filesystem>
-
-// Struktura do przechowywania parametrów symulacji
-struct ParametrSymulacji {
-    double T0;           // temperatura początkowa
-    double T_inf;        // temperatura końcowa
-    double alpha;        // współczynnik chłodzenia
-    int kroki;           // liczba kroków
-    bool losowa_init;    // sposób inicjalizacji (true = losowa, false = linia prosta)
-    
-    // Konstruktor
-    ParametrSymulacji(double t0, double t_inf, double a, int k, bool los) 
-        : T0(t0), T_inf(t_inf), alpha(a), kroki(k), losowa_init(los) {}
-};
+#include <random>
+#include <cstdlib>
+#include <stdexcept>
 
 // Funkcja sprawdzająca i tworząca katalog Out, jeśli nie istnieje
 void zapewnij_katalog_out() {
@@ -28,86 +29,55 @@ void zapewnij_katalog_out() {
     }
 }
 
-// Funkcja kopiująca pliki z katalogu głównego do katalogu Out
-void kopiuj_do_out(const std::string& nazwa_pliku) {
-    namespace fs = std::filesystem;
-    if (fs::exists(nazwa_pliku)) {
-        fs::copy_file(nazwa_pliku, "Out/" + nazwa_pliku, fs::copy_options::overwrite_existing);
-        std::cout << "Skopiowano " << nazwa_pliku << " do katalogu Out/" << std::endl;
-    } else {
-        std::cerr << "Błąd: Plik " << nazwa_pliku << " nie istnieje i nie może być skopiowany." << std::endl;
-    }
-}
-
-// Funkcja przeprowadzająca pojedynczą symulację z danymi parametrami
-void uruchom_symulacje(const ParametrSymulacji& params, std::ofstream& wyniki_plik) {
-    // Inicjalizacja modelu HP - używamy konstruktora bezparametrowego
-    HP_model model;
-    
-    // Próbujemy wygenerować początkową konformację
-    int proby = 0;
-    const int max_proby = 1000;
-    bool sukces = false;
-    
-    while (!sukces && proby < max_proby) {
-        sukces = model.generuj_startowa_konformacje(params.losowa_init);
-        proby++;
-    }
-    
-    if (!sukces) {
-        std::cerr << "Nie udało się wygenerować początkowej konformacji po " << max_proby << " próbach!" << std::endl;
+// Funkcja wypisująca wynik pojedynczego przebiegu w tabeli na ekranie
+void wypisz_wynik(const WynikPrzebiegu& wynik) {
+    const ParametrSymulacji& params = wynik.params;
+    if (!wynik.sukces) {
+        std::cerr << "Nie udało się wygenerować początkowej konformacji ("
+                  << wynik.katalog << ")!" << std::endl;
         return;
     }
-    
-    // Uruchamiamy symulację
-    model.algorytm_metropolisa(params.T0, params.T_inf, params.alpha, params.kroki);
-    
-    // Obliczamy końcową energię
-    double energia_koncowa = model.oblicz_energie();
-    
-    // Pobieramy statystyki akceptowanych ruchów
-    int akceptowane_koniec = model.get_zaakceptowane_koniec();
-    int akceptowane_naroznik = model.get_zaakceptowane_naroznik();
-    int akceptowane_crankshaft = model.get_zaakceptowane_crankshaft();
-    
-    // Kopiujemy pliki wynikowe do katalogu Out
-    kopiuj_do_out("energia.txt");
-    kopiuj_do_out("trajektoria.txt");
-    kopiuj_do_out("koncowa_konformacja.txt");
-    
-    // Zapisujemy wyniki do pliku CSV
-    wyniki_plik << (params.losowa_init ? "losowa" : "liniowa") << ","
-                << params.T0 << ","
-                << params.T_inf << ","
-                << params.alpha << ","
-                << params.kroki << ","
-                << energia_koncowa << ","
-                << akceptowane_koniec << ","
-                << akceptowane_naroznik << ","
-                << akceptowane_crankshaft << "\n";
-    
-    // Wyświetlamy wyniki na ekranie
     std::cout << std::setw(15) << (params.losowa_init ? "losowa" : "liniowa")
               << std::setw(10) << params.T0
               << std::setw(10) << params.T_inf
               << std::setw(10) << params.alpha
               << std::setw(10) << params.kroki
-              << std::setw(10) << energia_koncowa
-              << std::setw(10) << akceptowane_koniec
-              << std::setw(15) << akceptowane_naroznik
-              << std::setw(15) << akceptowane_crankshaft << std::endl;
+              << std::setw(10) << wynik.energia
+              << std::setw(10) << wynik.akceptowane_koniec
+              << std::setw(15) << wynik.akceptowane_naroznik
+              << std::setw(15) << wynik.akceptowane_crankshaft
+              << std::setw(10) << wynik.akceptowane_pull << std::endl;
 }
 
-// Funkcja przeprowadzająca serię testów z różnymi parametrami
+// Funkcja przeprowadzająca serię testów z różnymi parametrami (równolegle)
 void przeprowadz_testy() {
     // Zapewniamy, że katalog Out istnieje
     zapewnij_katalog_out();
     
-    // Otwieramy plik do zapisywania wyników
-    std::ofstream wyniki_plik("Out/wyniki_testow.csv");
-    
-    // Nagłówek pliku CSV
-    wyniki_plik << "Inicjalizacja,T0,T_inf,alpha,Kroki,Energia,Akc_end,Akc_corner,Akc_crankshaft\n";
+    // Siatka parametrów: dla obu metod inicjalizacji - liniowej i losowej
+    std::vector<ParametrSymulacji> siatka;
+    for (bool losowa_init : {false, true}) {
+        siatka.emplace_back(10.0, 1.0, 0.999, 10000, losowa_init);   // Test 1: Parametry domyślne
+        siatka.emplace_back(5.0, 1.0, 0.999, 10000, losowa_init);    // Test 2: Niska temperatura początkowa
+        siatka.emplace_back(20.0, 1.0, 0.999, 10000, losowa_init);   // Test 3: Wysoka temperatura początkowa
+        siatka.emplace_back(10.0, 0.5, 0.999, 10000, losowa_init);   // Test 4: Niska temperatura końcowa
+        siatka.emplace_back(10.0, 2.0, 0.999, 10000, losowa_init);   // Test 5: Wysoka temperatura końcowa
+        siatka.emplace_back(10.0, 1.0, 0.995, 10000, losowa_init);   // Test 6: Szybkie schładzanie
+        siatka.emplace_back(10.0, 1.0, 0.9999, 10000, losowa_init);  // Test 7: Wolne schładzanie
+        siatka.emplace_back(10.0, 1.0, 0.999, 5000, losowa_init);    // Test 8: Mała liczba kroków
+        siatka.emplace_back(10.0, 1.0, 0.999, 20000, losowa_init);   // Test 9: Duża liczba kroków
+    }
+
+    // Ziarno bazowe wypisujemy, aby każdy przebieg dało się odtworzyć
+    const uint64_t ziarno_bazowe = (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+    std::cout << "Przegląd " << siatka.size() << " zestawów parametrów, ziarno bazowe: "
+              << ziarno_bazowe << std::endl;
+
+    // Przebieg zamarznięty na plateau energii kończy się przed limitem kroków
+    UstawieniaZbieznosci zbieznosc;
+    zbieznosc.okno_plateau = 3000;
+    zbieznosc.okno_akceptacji = 1000;
+    std::vector<WynikPrzebiegu> wyniki = przeprowadz_przeglad(siatka, 1, ziarno_bazowe, "Out/przeglad", 0, &zbieznosc);
     
     // Nagłówek tabeli w konsoli
     std::cout << std::setw(15) << "Inicjalizacja" 
@@ -118,60 +88,30 @@ void przeprowadz_testy() {
               << std::setw(10) << "Energia" 
               << std::setw(10) << "Akc_end" 
               << std::setw(15) << "Akc_corner" 
-              << std::setw(15) << "Akc_crankshaft" << std::endl;
-    
-    std::cout << std::string(105, '-') << std::endl;
+              << std::setw(15) << "Akc_crankshaft"
+              << std::setw(10) << "Akc_pull" << std::endl;
     
-    // Dla obu metod inicjalizacji - liniowej i losowej
-    for (bool losowa_init : {false, true}) {
-        // Test 1: Parametry domyślne
-        std::cout << "Test 1: Parametry domyślne, inicjalizacja " 
-                  << (losowa_init ? "losowa" : "liniowa") << std::endl;
-        uruchom_symulacje(ParametrSymulacji(10.0, 1.0, 0.999, 10000, losowa_init), wyniki_plik);
-        
-        // Test 2: Niska temperatura początkowa
-        std::cout << "Test 2: Niska temperatura początkowa, inicjalizacja " 
-                  << (losowa_init ? "losowa" : "liniowa") << std::endl;
-        uruchom_symulacje(ParametrSymulacji(5.0, 1.0, 0.999, 10000, losowa_init), wyniki_plik);
-        
-        // Test 3: Wysoka temperatura początkowa
-        std::cout << "Test 3: Wysoka temperatura początkowa, inicjalizacja " 
-                  << (losowa_init ? "losowa" : "liniowa") << std::endl;
-        uruchom_symulacje(ParametrSymulacji(20.0, 1.0, 0.999, 10000, losowa_init), wyniki_plik);
-        
-        // Test 4: Niska temperatura końcowa
-        std::cout << "Test 4: Niska temperatura końcowa, inicjalizacja " 
-                  << (losowa_init ? "losowa" : "liniowa") << std::endl;
-        uruchom_symulacje(ParametrSymulacji(10.0, 0.5, 0.999, 10000, losowa_init), wyniki_plik);
-        
-        // Test 5: Wysoka temperatura końcowa
-        std::cout << "Test 5: Wysoka temperatura końcowa, inicjalizacja " 
-                  << (losowa_init ? "losowa" : "liniowa") << std::endl;
-        uruchom_symulacje(ParametrSymulacji(10.0, 2.0, 0.999, 10000, losowa_init), wyniki_plik);
-        
-        // Test 6: Szybkie schładzanie
-        std::cout << "Test 6: Szybkie schładzanie, inicjalizacja " 
-                  << (losowa_init ? "losowa" : "liniowa") << std::endl;
-        uruchom_symulacje(ParametrSymulacji(10.0, 1.0, 0.995, 10000, losowa_init), wyniki_plik);
-        
-        // Test 7: Wolne schładzanie
-        std::cout << "Test 7: Wolne schładzanie, inicjalizacja " 
-                  << (losowa_init ? "losowa" : "liniowa") << std::endl;
-        uruchom_symulacje(ParametrSymulacji(10.0, 1.0, 0.9999, 10000, losowa_init), wyniki_plik);
-        
-        // Test 8: Mała liczba kroków
-        std::cout << "Test 8: Mała liczba kroków, inicjalizacja " 
-                  << (losowa_init ? "losowa" : "liniowa") << std::endl;
-        uruchom_symulacje(ParametrSymulacji(10.0, 1.0, 0.999, 5000, losowa_init), wyniki_plik);
-        
-        // Test 9: Duża liczba kroków
-        std::cout << "Test 9: Duża liczba kroków, inicjalizacja " 
-                  << (losowa_init ? "losowa" : "liniowa") << std::endl;
-        uruchom_symulacje(ParametrSymulacji(10.0, 1.0, 0.999, 20000, losowa_init), wyniki_plik);
+    std::cout << std::string(115, '-') << std::endl;
+    for (const auto& wynik : wyniki) {
+        wypisz_wynik(wynik);
     }
     
+    // Wyniki w stałej kolejności, niezależnej od kolejności wykonania przebiegów
+    std::ofstream wyniki_plik("Out/wyniki_testow.csv");
+    zapisz_wyniki_csv(wyniki, wyniki_plik);
     wyniki_plik.close();
     std::cout << "Wyniki zostały zapisane do pliku 'Out/wyniki_testow.csv'" << std::endl;
+    std::ofstream statystyki_plik("Out/statystyki_testow.csv");
+    zapisz_statystyki_csv(wyniki, statystyki_plik);
+    std::cout << "Scalone statystyki energii zapisane do pliku 'Out/statystyki_testow.csv'" << std::endl;
+
+    long long zaplanowane = 0, wykonane = 0;
+    for (const auto& wynik : wyniki) {
+        if (!wynik.sukces) continue;
+        zaplanowane += wynik.params.kroki;
+        wykonane += wynik.wykonane_kroki;
+    }
+    std::cout << "Wykonano " << wykonane << " z " << zaplanowane << " zaplanowanych kroków" << std::endl;
 }
 
 // Funkcja testująca najlepsze parametry i zapisująca historię energii
@@ -183,6 +123,7 @@ void testuj_najlepsze_parametry() {
     
     // Inicjalizacja modelu z domyślną sekwencją
     HP_model model;
+    model.ustaw_katalog_wyjsciowy("Out");
     
     if (model.generuj_startowa_konformacje(true)) {  // inicjalizacja losowa
         // Najlepsze parametry na podstawie wyników testów
@@ -194,11 +135,6 @@ void testuj_najlepsze_parametry() {
         // Uruchamiamy algorytm Metropolisa
         model.algorytm_metropolisa(T0, T_inf, alpha, kroki);
         
-        // Kopiujemy pliki wynikowe do katalogu Out
-        kopiuj_do_out("energia.txt");
-        kopiuj_do_out("trajektoria.txt");
-        kopiuj_do_out("koncowa_konformacja.txt");
-        
         // Wyświetlamy statystyki
         model.wypisz_statystyki();
         
@@ -209,6 +145,296 @@ void testuj_najlepsze_parametry() {
     }
 }
 
+// Funkcja uruchamiająca wymianę replik (parallel tempering) do osiągnięcia energii docelowej
+void uruchom_wymiane_replik(uint64_t ziarno, const std::string& sekwencja, int energia_docelowa) {
+    zapewnij_katalog_out();
+    
+    UstawieniaWymiany ustawienia;       // liczba replik = liczba rdzeni
+    ustawienia.sekwencja = sekwencja;
+    ustawienia.T_min = 0.5;
+    ustawienia.T_max = 3.0;
+    ustawienia.energia_docelowa = energia_docelowa;
+    ustawienia.maks_krokow = 2000000;
+    ustawienia.ziarno = ziarno;
+    
+    std::cout << "\nWymiana replik: energia docelowa " << ustawienia.energia_docelowa
+              << ", ziarno: " << ustawienia.ziarno << std::endl;
+    
+    WymianaReplik wymiana(ustawienia);
+    if (!wymiana.uruchom()) {
+        std::cerr << "Nie udało się wygenerować początkowych konformacji replik!" << std::endl;
+        return;
+    }
+    wymiana.wypisz_statystyki(std::cout);
+    
+    // Najlepsza konformacja w formacie koncowa_konformacja.txt
+    std::filesystem::create_directories("Out/wymiana_replik");
+    std::ofstream plik("Out/wymiana_replik/koncowa_konformacja.txt");
+    for (const auto& poz : wymiana.get_najlepsza_konformacja()) {
+        plik << poz.x << " " << poz.y << " " << poz.z << "\n";
+    }
+    std::cout << "Najlepsza konformacja zapisana do pliku 'Out/wymiana_replik/koncowa_konformacja.txt'" << std::endl;
+}
+
+// Funkcja szukająca konformacji o najniższej energii metodą wzrostu łańcucha (PERM)
+void uruchom_perm(uint64_t ziarno) {
+    zapewnij_katalog_out();
+    
+    UstawieniaPERM ustawienia;
+    ustawienia.T = 0.35;
+    ustawienia.maks_wezlow = 20000000;
+    ustawienia.ziarno = ziarno;
+    
+    HP_model model;  // źródło sekwencji
+    std::cout << "PERM (nPERMis), T = " << ustawienia.T << ", ziarno: " << ustawienia.ziarno << std::endl;
+    
+    PERM perm(model.get_sekwencja(), ustawienia);
+    if (!perm.uruchom()) {
+        std::cerr << "PERM nie wyhodował żadnego pełnego łańcucha!" << std::endl;
+        return;
+    }
+    perm.wypisz_statystyki(std::cout);
+    
+    perm.zapisz_konformacje("Out/koncowa_konformacja.txt");
+    std::cout << "Końcowa konformacja (energia " << perm.get_najlepsza_energia()
+              << ") zapisana do pliku 'Out/koncowa_konformacja.txt'" << std::endl;
+}
+
+// Dokładny stan podstawowy krótkiej sekwencji przez pełną enumerację konformacji
+int uruchom_enumeracje(const std::string& sekwencja, size_t watki) {
+    zapewnij_katalog_out();
+    if (sekwencja.empty() || sekwencja.find_first_not_of("HP") != std::string::npos) {
+        std::cerr << "Niepoprawna sekwencja (dozwolone tylko H i P): " << sekwencja << std::endl;
+        return 1;
+    }
+    
+    UstawieniaEnumeracji ustawienia;
+    ustawienia.watki = watki;
+    std::cout << "Enumeracja dokładna, " << sekwencja.size() << " aminokwasów" << std::endl;
+    
+    Enumeracja enumeracja(sekwencja, ustawienia);
+    const bool pelna = enumeracja.uruchom();
+    enumeracja.wypisz_statystyki(std::cout);
+    if (!pelna) return 1;
+    
+    enumeracja.zapisz_konformacje("Out/koncowa_konformacja.txt");
+    std::cout << "Przykładowa konformacja w stanie podstawowym zapisana do pliku 'Out/koncowa_konformacja.txt'"
+              << std::endl;
+    return 0;
+}
+
+// Funkcja wyznaczająca gęstość stanów g(E) metodą Wanga-Landaua
+void uruchom_wang_landau(uint64_t ziarno) {
+    zapewnij_katalog_out();
+    
+    UstawieniaWL ustawienia;
+    ustawienia.energia_minimalna = -25;  // okno energii osiągalne w rozsądnym czasie
+    ustawienia.maks_krokow = 50000000;
+    ustawienia.ziarno = ziarno;
+    
+    std::cout << "Wang-Landau, okno energii [" << ustawienia.energia_minimalna
+              << ", 0], ziarno: " << ustawienia.ziarno << std::endl;
+    
+    // Propozycje ze strumienia 0, akceptacja WL ze strumienia 1 - ciągi niezależne
+    HP_model model;
+    model.ustaw_strumien(ustawienia.ziarno, 0);
+    model.ustaw_gadatliwosc(Gadatliwosc::Cisza);
+    WangLandau wl(ustawienia);
+    if (!wl.uruchom(model)) {
+        std::cerr << "Nie udało się wygenerować początkowej konformacji!" << std::endl;
+        return;
+    }
+    wl.wypisz_statystyki(std::cout);
+    
+    // Termodynamika w kilku temperaturach z jednego przebiegu
+    std::cout << std::setw(10) << "T" << std::setw(12) << "<E>" << std::setw(12) << "C" << std::endl;
+    for (double T : {0.3, 0.5, 0.75, 1.0, 1.5, 2.0}) {
+        double srednia_energia, cieplo_wlasciwe;
+        wl.termodynamika(T, srednia_energia, cieplo_wlasciwe);
+        std::cout << std::setw(10) << T << std::setw(12) << srednia_energia
+                  << std::setw(12) << cieplo_wlasciwe << std::endl;
+    }
+    
+    wl.zapisz_gestosc("Out/gestosc_stanow.txt");
+    std::cout << "Gęstość stanów zapisana do pliku 'Out/gestosc_stanow.txt'" << std::endl;
+    std::cout << "Termodynamika w dowolnej temperaturze: python ../Python/termodynamika.py [T ...]" << std::endl;
+}
+
+// Wsadowe zwijanie sekwencji z pliku (lub standardowego wejścia przy "-")
+int uruchom_wsadowo(const std::string& plik_wejsciowy, const std::string& plik_wyjsciowy, int kroki) {
+    std::ifstream plik;
+    if (plik_wejsciowy != "-") {
+        plik.open(plik_wejsciowy);
+        if (!plik) {
+            std::cerr << "Nie można otworzyć pliku " << plik_wejsciowy << std::endl;
+            return 1;
+        }
+    }
+    std::ofstream wyjscie(plik_wyjsciowy);
+    if (!wyjscie) {
+        std::cerr << "Nie można utworzyć pliku " << plik_wyjsciowy << std::endl;
+        return 1;
+    }
+    
+    UstawieniaWsadowe ustawienia;
+    ustawienia.kroki = kroki;
+    StatystykiWsadowe statystyki = przetworz_wsadowo(plik_wejsciowy == "-" ? std::cin : plik, wyjscie, ustawienia);
+    
+    std::cout << "Zwinięto sekwencji: " << statystyki.sekwencje << " (błędnych: " << statystyki.bledne
+              << ") w " << statystyki.czas << " s" << std::endl;
+    std::cout << "Wyniki zapisane do pliku '" << plik_wyjsciowy << "'" << std::endl;
+    return 0;
+}
+
+// Zwinięcie jednej sekwencji przez API biblioteki hp_core, bez plików wynikowych
+int uruchom_zwijanie(const std::string& sekwencja, long long kroki, uint64_t ziarno) {
+    hp_zadanie zadanie{};
+    zadanie.sekwencja = sekwencja.c_str();
+    hp_parametry_domyslne(&zadanie.parametry);
+    zadanie.parametry.kroki = kroki;
+    zadanie.parametry.ziarno = ziarno;
+    std::vector<int32_t> konformacja(3 * sekwencja.size());
+    zadanie.konformacja = konformacja.data();
+    zadanie.pojemnosc = sekwencja.size();
+    
+    if (hp_zwin(&zadanie) != HP_OK) {
+        std::cerr << "Błąd: " << hp_opis_statusu(zadanie.status) << std::endl;
+        return 1;
+    }
+    std::cout << "Energia: " << zadanie.energia << " po " << zadanie.wykonane_kroki << " krokach" << std::endl;
+    for (size_t i = 0; i < zadanie.dlugosc; ++i) {
+        std::cout << konformacja[3 * i] << " " << konformacja[3 * i + 1] << " " << konformacja[3 * i + 2] << "\n";
+    }
+    return 0;
+}
+
+// Zwinięcie jednej sekwencji w modelu macierzowym (HPNX, MJ) - API hp_core obsługuje tylko H/P.
+// Temperatury domyślne API są w jednostkach kontaktu H-H, więc mnoży je skala tabeli.
+template <typename ModelMacierzowy>
+int uruchom_zwijanie_macierzowe(const std::string& sekwencja, long long kroki, uint64_t ziarno, double skala) {
+    hp_parametry parametry;
+    hp_parametry_domyslne(&parametry);
+    try {
+        ModelMacierzowy model(sekwencja);
+        model.ustaw_gadatliwosc(Gadatliwosc::Cisza);
+        model.ustaw_interwal_raportu(0);
+        model.ustaw_zapis_plikow(false);
+        model.ustaw_ziarno(ziarno);
+        model.ustaw_tryb_propozycji(ModelMacierzowy::TrybPropozycji::Lokalny);
+        if (!model.generuj_startowa_konformacje(true)) {
+            std::cerr << "Błąd: " << hp_opis_statusu(HP_BLAD_STARTU) << std::endl;
+            return 1;
+        }
+        model.algorytm_metropolisa(skala * parametry.T0, skala * parametry.T_inf, parametry.alpha,
+                                   static_cast<int>(kroki));
+        std::cout << "Energia: " << model.get_najlepsza_energia() << " po " << model.get_kroki_przebiegu()
+                  << " krokach" << std::endl;
+        for (const Vec3& p : model.get_najlepsze_pozycje()) {
+            std::cout << p.x << " " << p.y << " " << p.z << "\n";
+        }
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Błąd: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Wyżarzanie długiego łańcucha (losowa sekwencja HP) na wszystkich rdzeniach metodą szachownicy
+int uruchom_szachownice(size_t dlugosc, long long przemiatania, size_t watki, uint64_t ziarno) {
+    zapewnij_katalog_out();
+    Xoshiro256 gen(ziarno);
+    std::string sekwencja(dlugosc, 'P');
+    for (auto& aminokwas : sekwencja) {
+        if (gen.ponizej(2)) aminokwas = 'H';
+    }
+    
+    HP_model model(sekwencja);
+    model.ustaw_ziarno(ziarno);
+    model.ustaw_gadatliwosc(Gadatliwosc::Cisza);
+    if (!model.generuj_startowa_konformacje(true)) {
+        std::cerr << "Nie udało się wygenerować początkowej konformacji!" << std::endl;
+        return 1;
+    }
+    std::cout << "Wyżarzanie długiego łańcucha: " << dlugosc << " aminokwasów, " << przemiatania << " przemiatań, ziarno: "
+              << ziarno << std::endl;
+    
+    UstawieniaSzachownicy ustawienia;
+    ustawienia.watki = watki;
+    ustawienia.ziarno = ziarno;
+    SzachownicaMC szachownica(ustawienia);
+    szachownica.uruchom(model, 2.0, 0.3, 0.99, przemiatania);
+    szachownica.wypisz_statystyki(std::cout);
+    
+    std::ofstream plik("Out/koncowa_konformacja.txt");
+    for (const auto& poz : model.get_pozycje()) {
+        plik << poz.x << " " << poz.y << " " << poz.z << "\n";
+    }
+    std::cout << "Końcowa konformacja zapisana do pliku 'Out/koncowa_konformacja.txt'" << std::endl;
+    return 0;
+}
+
+// Długie wyżarzanie z punktami kontrolnymi; po przerwaniu wznawiane od ostatniego punktu
+void uruchom_wyzarzanie(int kroki, uint64_t ziarno) {
+    zapewnij_katalog_out();
+    const std::string sciezka = "Out/punkt_kontrolny.bin";
+    
+    HP_model model;
+    model.ustaw_katalog_wyjsciowy("Out");
+    model.ustaw_interwal_raportu(100000);
+    model.ustaw_krok_zapisu_trajektorii(1000);
+    model.ustaw_punkty_kontrolne(sciezka, 1000000);
+
+    // Pamięć konformacji (tylko rejestracja, bez kary tabu) do zliczenia różnych minimów
+    PamiecKonformacji pamiec(1 << 20);
+    model.ustaw_pamiec_konformacji(&pamiec);
+
+    // Chłodzenie sterowane akceptacją; zamarznięty łańcuch startuje od nowa (najwyżej 3 razy)
+    HarmonogramAdaptacyjny harmonogram(0.999999, 0.3, 0.05, 10000);
+    model.ustaw_harmonogram(&harmonogram);
+    UstawieniaZbieznosci zbieznosc;
+    zbieznosc.okno_plateau = 1000000;
+    zbieznosc.okno_akceptacji = 100000;
+    zbieznosc.maks_restartow = 3;
+    DetektorZbieznosci detektor(zbieznosc);
+    model.ustaw_detektor_zbieznosci(&detektor);
+
+    // Statystyki energii w trakcie przebiegu zamiast energia.txt z każdym krokiem
+    StatystykiPrzebiegu statystyki(100000);
+    model.ustaw_statystyki(&statystyki);
+    model.ustaw_zapis_energii(false);
+    
+    if (model.wczytaj_punkt_kontrolny(sciezka)) {
+        std::cout << "Wczytano punkt kontrolny " << sciezka << std::endl;
+    } else {
+        std::cout << "Nowy przebieg, ziarno: " << ziarno << std::endl;
+        model.ustaw_ziarno(ziarno);
+        bool sukces = false;
+        for (int proby = 0; !sukces && proby < 1000; ++proby) {
+            sukces = model.generuj_startowa_konformacje(true);
+        }
+        if (!sukces) {
+            std::cerr << "Nie udało się wygenerować początkowej konformacji!" << std::endl;
+            return;
+        }
+    }
+    
+    model.algorytm_metropolisa(10.0, 0.3, 0.999999, kroki);
+    model.wypisz_statystyki();
+    std::cout << "Wykonane kroki: " << model.get_kroki_przebiegu() << " z " << kroki
+              << ", restarty: " << detektor.get_restarty() << std::endl;
+    std::cout << "Średnia energia: " << statystyki.get_srednia() << " ± " << statystyki.get_blad_sredniej()
+              << " (τ_int = " << statystyki.get_czas_autokorelacji() << " kroków), najlepsza "
+              << statystyki.get_najlepsza_energia() << " w kroku " << statystyki.get_krok_najlepszej()
+              << "; podsumowanie w 'Out/statystyki.txt'" << std::endl;
+    const int minimum = pamiec.najnizsza_energia();
+    std::cout << "Najniższa energia: " << minimum << ", różnych konformacji o tej energii: "
+              << pamiec.zlicz_konformacje(minimum) << " (zapamiętanych konformacji: " << pamiec.rozmiar()
+              << ")" << std::endl;
+    
+    // Przebieg zakończony - punkt kontrolny nie jest już potrzebny
+    std::filesystem::remove(sciezka);
+}
+
 // Dodanie informacji o autorze i dacie kompilacji
 void wyswietl_informacje() {
     std::cout << "=== Program do symulacji zwijania białek w modelu HP ===" << std::endl;
@@ -217,10 +443,82 @@ void wyswietl_informacje() {
     std::cout << "==========================================================" << std::endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     // Wyświetl informacje o programie
     wyswietl_informacje();
     
+    // Wybór metody: zwin, wsadowo, metropolis, perm, wang-landau, wyzarzanie, wymiana, dokladnie albo szachownica;
+    // bez argumentów tylko opis użycia
+    const std::string metoda = argc > 1 ? argv[1] : "";
+    if (metoda == "perm") {
+        // perm [ziarno]
+        uruchom_perm(argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1);
+        return 0;
+    }
+    if (metoda == "wang-landau") {
+        // wang-landau [ziarno]
+        uruchom_wang_landau(argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1);
+        return 0;
+    }
+    if (metoda == "wyzarzanie") {
+        // wyzarzanie [kroki] [ziarno]
+        const int kroki = argc > 2 ? std::atoi(argv[2]) : 10000000;
+        const uint64_t ziarno = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+        uruchom_wyzarzanie(kroki, ziarno);
+        return 0;
+    }
+    if (metoda == "wymiana") {
+        // wymiana [ziarno] [sekwencja] [energia_docelowa]; cel -45 tylko dla sekwencji domyślnej
+        const std::string sekwencja = argc > 3 ? argv[3] : "";
+        uruchom_wymiane_replik(argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1, sekwencja,
+                               argc > 4 ? std::atoi(argv[4]) : (sekwencja.empty() ? -45 : 0));
+        return 0;
+    }
+    if (metoda == "dokladnie" && argc > 2) {
+        // dokladnie <sekwencja> [watki]
+        return uruchom_enumeracje(argv[2], argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 0);
+    }
+    if (metoda == "wsadowo" && argc > 2) {
+        // wsadowo <plik|-> [plik_wyjsciowy] [kroki]
+        zapewnij_katalog_out();
+        const std::string wyjscie = argc > 3 ? argv[3] : "Out/wyniki_wsadowe.csv";
+        return uruchom_wsadowo(argv[2], wyjscie, argc > 4 ? std::atoi(argv[4]) : 200000);
+    }
+    if (metoda == "zwin" && argc > 2) {
+        // zwin <sekwencja> [kroki] [ziarno] [hp|hpnx|mj]
+        const long long kroki = argc > 3 ? std::atoll(argv[3]) : 10000;
+        const uint64_t ziarno = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 1;
+        const std::string rodzaj = argc > 5 ? argv[5] : "hp";
+        if (rodzaj == "hpnx") return uruchom_zwijanie_macierzowe<HPNX_model>(argv[2], kroki, ziarno, 1.0);
+        if (rodzaj == "mj") return uruchom_zwijanie_macierzowe<MJ_model>(argv[2], kroki, ziarno, TabelaMJ::SKALA);
+        if (rodzaj != "hp") {
+            std::cerr << "Nieznany model: " << rodzaj << " (hp, hpnx albo mj)" << std::endl;
+            return 1;
+        }
+        return uruchom_zwijanie(argv[2], kroki, ziarno);
+    }
+    if (metoda == "szachownica") {
+        // szachownica [dlugosc] [przemiatania] [watki] [ziarno]
+        return uruchom_szachownice(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10000,
+                                   argc > 3 ? std::atoll(argv[3]) : 1000,
+                                   argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 0,
+                                   argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 1);
+    }
+    if (metoda != "metropolis") {
+        std::cerr << "Użycie: " << argv[0] << " <metoda> [argumenty]\n"
+                  << "  zwin <sekwencja> [kroki] [ziarno] [hp|hpnx|mj]    jedna sekwencja (hp przez API hp_core)\n"
+                  << "  wsadowo <plik|-> [plik_wyjsciowy] [kroki]         wiele sekwencji przez API hp_core\n"
+                  << "  metropolis                                        przegląd parametrów i przebieg z zapisem wyników\n"
+                  << "  perm [ziarno]                                     PERM dla sekwencji domyślnej\n"
+                  << "  wang-landau [ziarno]                              gęstość stanów sekwencji domyślnej\n"
+                  << "  wyzarzanie [kroki] [ziarno]                       długie wyżarzanie z punktami kontrolnymi\n"
+                  << "  wymiana [ziarno] [sekwencja] [energia_docelowa]   wymiana replik na wszystkich rdzeniach\n"
+                  << "  dokladnie <sekwencja> [watki]                     stan podstawowy przez pełną enumerację\n"
+                  << "  szachownica [dlugosc] [przemiatania] [watki] [ziarno]  długi łańcuch metodą szachownicy"
+                  << std::endl;
+        return metoda.empty() ? 0 : 1;
+    }
+    
     // Uruchamiamy systematyczne testy parametrów
     przeprowadz_testy();
     
@@ -2,8 +2,17 @@ import numpy as np
 import matplotlib.pyplot as plt
 from mpl_toolkits.mplot3d import Axes3D
 import os
+import sys
 
-# Ścieżka do pliku koncowa_konformacja.txt
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from trajektoria import Trajektoria
+
+# Ścieżka do binarnej trajektorii (ostatnia klatka i sekwencja z nagłówka)
+traj_path = '../Out/trajektoria.bin'
+if not os.path.exists(traj_path):
+    traj_path = 'trajektoria.bin'
+
+# Ścieżka do pliku koncowa_konformacja.txt (gdy brak trajektorii)
 file_path = '../Out/koncowa_konformacja.txt'
 if not os.path.exists(file_path):
     file_path = 'koncowa_konformacja.txt'  # Próbuj lokalnie jako alternatywę
@@ -13,11 +22,22 @@ output_dir = '../Out'
 if not os.path.exists(output_dir):
     output_dir = '.'
 
-# Próbujemy wizualizować końcową konformację
+# Sekwencja HP z nagłówka trajektorii; gdy brak trajektorii - z wiersza poleceń (opcjonalnie)
+sekwencja_hp = sys.argv[1] if len(sys.argv) > 1 else ''
+
+# Próbujemy wizualizować końcową konformację (ostatnią klatkę trajektorii)
 try:
-    if os.path.exists(file_path):
+    positions = None
+    if os.path.exists(traj_path):
+        traj = Trajektoria(traj_path)
+        if len(traj) > 0:
+            _, _, positions = traj.klatka(-1)
+            sekwencja_hp = traj.sekwencja
+        traj.zamknij()
+    if positions is None and os.path.exists(file_path):
         positions = np.loadtxt(file_path)
-        
+
+    if positions is not None:
         fig = plt.figure(figsize=(8, 8))
         ax = fig.add_subplot(111, projection='3d')
         
@@ -27,11 +47,11 @@ try:
         
         ax.plot(x, y, z, 'o-', color='blue', linewidth=2)
         
-        # Sekwencja ubikwityny w modelu HP
-        sekwencja_hp = "PHPHHHHHPHPHPHHPPPPPHPPPPHHHPPPPPHPPPHHPHPHHHHPPPPHHHHPPHPHPHHHHHHHHHPPHHPP"
-        
-        # Kolorowanie hydrofobowych (H) i polarnych (P) aminokwasów
-        colors = ['red' if aa == 'H' else 'green' for aa in sekwencja_hp[:len(x)]]
+        # Kolorowanie hydrofobowych (H) i polarnych (P) aminokwasów (szary - nieznana sekwencja)
+        if len(sekwencja_hp) >= len(x):
+            colors = ['red' if aa == 'H' else 'green' for aa in sekwencja_hp[:len(x)]]
+        else:
+            colors = 'gray'
         ax.scatter(x, y, z, color=colors, s=100)
         
         ax.set_xlabel('X')
@@ -0,0 +1,73 @@
+import numpy as np
+import os
+import sys
+
+# Ścieżka do pliku gestosc_stanow.txt (wynik próbkowania Wanga-Landaua)
+file_path = '../Out/gestosc_stanow.txt'
+if not os.path.exists(file_path):
+    file_path = 'gestosc_stanow.txt'  # Próbuj lokalnie jako alternatywę
+
+
+def termodynamika(energie, ln_g, temperatury):
+    """
+    Średnia energia, ciepło właściwe, energia swobodna i entropia
+    dla każdej temperatury, wyznaczone z gęstości stanów g(E).
+    """
+    wyniki = []
+    for T in temperatury:
+        wykladnik = ln_g - energie / T
+        maks = wykladnik.max()
+        wagi = np.exp(wykladnik - maks)
+        Z = wagi.sum()
+        U = (wagi * energie).sum() / Z
+        U2 = (wagi * energie ** 2).sum() / Z
+        C = (U2 - U ** 2) / T ** 2
+        F = -T * (maks + np.log(Z))
+        S = (U - F) / T
+        wyniki.append((U, C, F, S))
+    return np.array(wyniki)
+
+
+# Wczytaj g(E): kolumny E, ln g(E), H(E)
+try:
+    dane = np.loadtxt(file_path)
+    energie = dane[:, 0]
+    ln_g = dane[:, 1]
+
+    # Temperatury z wiersza poleceń (np. python termodynamika.py 0.3 0.5 1.0) albo siatka
+    if len(sys.argv) > 1:
+        temperatury = np.array([float(t) for t in sys.argv[1:]])
+    else:
+        temperatury = np.linspace(0.1, 3.0, 300)
+    wyniki = termodynamika(energie, ln_g, temperatury)
+
+    if len(sys.argv) > 1:
+        print("T        <E>        C          F          S")
+        for T, (U, C, F, S) in zip(temperatury, wyniki):
+            print(f"{T:<8.3f} {U:<10.4f} {C:<10.4f} {F:<10.4f} {S:<10.4f}")
+    else:
+        import matplotlib.pyplot as plt
+
+        # Ścieżka do zapisania plików wynikowych
+        output_dir = '../Out'
+        if not os.path.exists(output_dir):
+            output_dir = '.'
+
+        fig, (ax1, ax2) = plt.subplots(2, 1, figsize=(10, 8), sharex=True)
+        ax1.plot(temperatury, wyniki[:, 0], 'b-')
+        ax1.set_ylabel('Średnia energia <E>')
+        ax1.grid(True, linestyle='--', alpha=0.7)
+        ax2.plot(temperatury, wyniki[:, 1], 'r-')
+        ax2.set_ylabel('Ciepło właściwe C')
+        ax2.set_xlabel('Temperatura T')
+        ax2.grid(True, linestyle='--', alpha=0.7)
+        ax1.set_title('Termodynamika z gęstości stanów (Wang-Landau)')
+
+        plt.savefig(f'{output_dir}/termodynamika.pdf', bbox_inches='tight')
+        plt.savefig(f'{output_dir}/termodynamika.png', bbox_inches='tight', dpi=300)
+        plt.close()
+
+        print(f"Wykresy termodynamiki zapisane w katalogu {output_dir} jako termodynamika.pdf i termodynamika.png")
+except Exception as e:
+    print(f"Błąd obliczania termodynamiki: {e}")
+    print("Upewnij się, że plik gestosc_stanow.txt istnieje w katalogu Out/ lub bieżącym katalogu.")
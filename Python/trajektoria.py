@@ -0,0 +1,60 @@
+import struct
+import os
+
+import numpy as np
+
+# Format binarnej trajektorii opisany w Header/Trajektoria.h
+MAGIA = b'HPTR'
+WERSJA = 1
+KIERUNKI = np.array([[1, 0, 0], [-1, 0, 0], [0, 1, 0], [0, -1, 0], [0, 0, 1], [0, 0, -1]])
+
+
+class Trajektoria:
+    """Swobodny dostęp do klatek pliku trajektoria.bin."""
+
+    def __init__(self, sciezka):
+        self.plik = open(sciezka, 'rb')
+        naglowek = self.plik.read(20)
+        if len(naglowek) < 20 or naglowek[:4] != MAGIA:
+            raise ValueError(f"{sciezka} nie jest trajektorią HPTR")
+        wersja, n, krok_zapisu, rozmiar_klatki = struct.unpack('<4I', naglowek[4:20])
+        if wersja != WERSJA:
+            raise ValueError(f"Nieobsługiwana wersja trajektorii: {wersja}")
+        self.n = n
+        self.krok_zapisu = krok_zapisu
+        self.rozmiar_klatki = rozmiar_klatki
+        self.sekwencja = self.plik.read(n).decode('ascii')
+        self.poczatek = 20 + n
+        rozmiar_danych = os.path.getsize(sciezka) - self.poczatek
+        # Urwana ostatnia klatka jest pomijana
+        self.liczba_klatek = rozmiar_danych // rozmiar_klatki
+
+    def __len__(self):
+        return self.liczba_klatek
+
+    def klatka(self, k):
+        """Zwraca (krok, energia, pozycje[n, 3]) dla klatki k (ujemne k liczone od końca)."""
+        if k < 0:
+            k += self.liczba_klatek
+        if not 0 <= k < self.liczba_klatek:
+            raise IndexError(k)
+        self.plik.seek(self.poczatek + k * self.rozmiar_klatki)
+        dane = self.plik.read(self.rozmiar_klatki)
+        krok, energia, x0, y0, z0 = struct.unpack('<qi3i', dane[:24])
+
+        bity = np.unpackbits(np.frombuffer(dane[24:], dtype=np.uint8), bitorder='little')
+        bity = bity[:3 * (self.n - 1)].reshape(-1, 3)
+        kody = bity[:, 0] | (bity[:, 1] << 1) | (bity[:, 2] << 2)
+
+        pozycje = np.zeros((self.n, 3), dtype=int)
+        pozycje[0] = (x0, y0, z0)
+        if self.n > 1:
+            pozycje[1:] = pozycje[0] + np.cumsum(KIERUNKI[kody], axis=0)
+        return krok, energia, pozycje
+
+    def __iter__(self):
+        for k in range(self.liczba_klatek):
+            yield self.klatka(k)
+
+    def zamknij(self):
+        self.plik.close()